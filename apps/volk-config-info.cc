@@ -59,6 +59,10 @@ int main(int argc, char** argv)
                              "",
                              "print the current VOLK machine that will be used",
                              volk_get_machine()));
+    our_options.add(option_t("fingerprint",
+                             "",
+                             "print the host fingerprint used for volk_config sections",
+                             volk_get_cpu_fingerprint()));
     our_options.add(
         option_t("alignment", "", "print the memory alignment", print_alignment));
     our_options.add(option_t("malloc",
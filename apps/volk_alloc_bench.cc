@@ -0,0 +1,174 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of VOLK
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+/*
+ * Times the allocation of scratch buffers the way processing functions
+ * make them: allocate, write every page, free, once per call. Compares
+ * volk_malloc with the thread cached volk_pool_malloc, on several threads
+ * at once to expose allocator locks.
+ */
+
+#include <volk/volk.h>      // for volk_get_alignment
+#include <volk/volk_pool.h> // for volk_pool_malloc, volk_pool_get_stats
+#include <algorithm>        // for max
+#include <atomic>           // for atomic
+#include <chrono>           // for steady_clock
+#include <cstdlib>          // for strtoul
+#include <cstring>          // for memset
+#include <iomanip>          // for setw
+#include <iostream>         // for cout, cerr
+#include <sstream>          // for istringstream
+#include <string>           // for string
+#include <thread>           // for thread
+#include <vector>           // for vector
+
+#include "volk_option_helpers.h" // for option_list, option_t
+
+namespace {
+
+typedef std::chrono::steady_clock bench_clock;
+
+std::string size_list("256,4k,64k,1M");
+int n_threads = 1;
+int n_calls = 100000;
+bool touch = true;
+
+void set_sizes(std::string val) { size_list = val; }
+void set_threads(int val) { n_threads = std::max(val, 1); }
+void set_calls(int val) { n_calls = std::max(val, 1); }
+void set_no_touch(bool val) { touch = !val; }
+
+struct allocator {
+    const char* name;
+    void* (*malloc)(size_t, size_t);
+    void (*free)(void*);
+};
+
+const allocator allocators[] = {
+    { "volk_malloc", volk_malloc, volk_free },
+    { "volk_pool_malloc", volk_pool_malloc, volk_pool_free },
+};
+
+bool parse_sizes(const std::string& text, std::vector<size_t>& sizes)
+{
+    std::istringstream stream(text);
+    std::string field;
+    while (std::getline(stream, field, ',')) {
+        char* end = nullptr;
+        unsigned long size = std::strtoul(field.c_str(), &end, 10);
+        if (*end == 'k' || *end == 'K') {
+            size <<= 10;
+            end++;
+        } else if (*end == 'm' || *end == 'M') {
+            size <<= 20;
+            end++;
+        }
+        if (end == field.c_str() || *end != '\0' || size == 0) {
+            return false;
+        }
+        sizes.push_back(size);
+    }
+    return !sizes.empty();
+}
+
+// ns per allocate, touch and free on each of n_threads threads at once
+double time_allocator(const allocator& alloc, size_t size)
+{
+    const size_t alignment = volk_get_alignment();
+    std::atomic<bool> go(false);
+    std::vector<double> ns(n_threads);
+    std::vector<std::thread> workers;
+    for (int ii = 0; ii < n_threads; ii++) {
+        workers.emplace_back([&, ii]() {
+            while (!go.load()) {
+            }
+            const auto start = bench_clock::now();
+            for (int call = 0; call < n_calls; call++) {
+                char* buffer = (char*)alloc.malloc(size, alignment);
+                if (touch) {
+                    for (size_t offset = 0; offset < size; offset += 4096) {
+                        buffer[offset] = (char)call;
+                    }
+                }
+                alloc.free(buffer);
+            }
+            ns[ii] = std::chrono::duration<double, std::nano>(bench_clock::now() - start)
+                         .count() /
+                     n_calls;
+        });
+    }
+    go.store(true);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    double sum = 0.0;
+    for (double thread_ns : ns) {
+        sum += thread_ns;
+    }
+    return sum / n_threads;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    option_list bench_options("volk_alloc_bench");
+    bench_options.add(option_t("sizes",
+                               "s",
+                               "Comma separated sizes in bytes, k and M suffixes allowed",
+                               set_sizes));
+    bench_options.add(
+        option_t("threads", "T", "Threads allocating at the same time", set_threads));
+    bench_options.add(
+        option_t("calls", "n", "Allocations per thread and size", set_calls));
+    bench_options.add(option_t("no-touch",
+                               "N",
+                               "Do not write to the buffers between malloc and free",
+                               set_no_touch));
+    try {
+        bench_options.parse(argc, argv);
+    } catch (...) {
+        return 1;
+    }
+    if (bench_options.present("help")) {
+        return 0;
+    }
+
+    std::vector<size_t> sizes;
+    if (!parse_sizes(size_list, sizes)) {
+        std::cerr << "Invalid sizes " << size_list << std::endl;
+        return 1;
+    }
+
+    std::cout << n_threads << " threads, " << n_calls << " calls each, ns per call"
+              << std::endl;
+    std::cout << std::setw(10) << "bytes";
+    for (const auto& alloc : allocators) {
+        std::cout << std::setw(20) << alloc.name;
+    }
+    std::cout << std::setw(10) << "speedup" << std::endl;
+    for (size_t size : sizes) {
+        std::cout << std::setw(10) << size;
+        std::vector<double> ns;
+        for (const auto& alloc : allocators) {
+            ns.push_back(time_allocator(alloc, size));
+            std::cout << std::setw(20) << ns.back();
+        }
+        std::cout << std::setw(10) << ns.front() / ns.back() << std::endl;
+    }
+
+    volk_pool_stats_t stats;
+    volk_pool_get_stats(&stats);
+    std::cout << "Pool: " << stats.allocations << " allocations, " << stats.hits
+              << " hits, " << stats.misses << " misses, " << stats.large << " large, "
+              << stats.frees << " frees, " << stats.releases << " releases, "
+              << stats.cached_bytes << " bytes cached by " << stats.threads
+              << " threads" << std::endl;
+    return 0;
+}
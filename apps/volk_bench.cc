@@ -0,0 +1,353 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of VOLK
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+/*
+ * Times the kernels one call at a time, without writing a volk_config.
+ * The cases are generated from the kernel headers, so every kernel with a
+ * num_points argument has one, those of out-of-tree modules included.
+ */
+
+#include <volk/volk.h> // for volk_func_desc_t
+#include <algorithm>   // for sort, max, min
+#include <chrono>      // for steady_clock
+#include <cstdlib>     // for strtoul
+#include <fstream>     // for ofstream
+#include <iomanip>     // for setw, setprecision
+#include <iostream>    // for cout, cerr
+#include <map>         // for map
+#include <regex>       // for regex, regex_search
+#include <sstream>     // for istringstream
+#include <string>      // for string
+#include <vector>      // for vector
+
+#include "volk_bench.h"
+#include "volk_option_helpers.h" // for option_list, option_t
+
+namespace {
+
+typedef std::chrono::steady_clock bench_clock;
+
+std::string case_filter("");
+std::string vlen_list("131071");
+std::map<std::string, std::string> case_vlen_lists;
+int repetitions = 5;
+float min_time_ms = 10.f;
+std::string pointer_modes("aligned");
+std::string input_name("uniform");
+std::string impl_selection("all");
+bool list_cases = false;
+std::string json_filename("");
+std::string csv_filename("");
+
+void set_filter(std::string val) { case_filter = val; }
+void set_vlen(std::string val) { vlen_list = val; }
+void set_case_vlen(std::string val)
+{
+    const size_t equals = val.find('=');
+    if (equals == std::string::npos) {
+        std::cerr << "Expected kernel=lengths, got " << val << std::endl;
+        return;
+    }
+    case_vlen_lists[val.substr(0, equals)] = val.substr(equals + 1);
+}
+void set_repetitions(int val) { repetitions = std::max(val, 1); }
+void set_min_time(float val) { min_time_ms = std::max(val, 0.f); }
+void set_pointers(std::string val) { pointer_modes = val; }
+void set_input(std::string val) { input_name = val; }
+void set_impls(std::string val) { impl_selection = val; }
+void set_list(bool val) { list_cases = val; }
+void set_json(std::string val) { json_filename = val; }
+void set_csv(std::string val) { csv_filename = val; }
+
+struct pointer_mode {
+    std::string name;
+    unsigned int offset; // in elements
+};
+
+struct bench_result {
+    std::string kernel;
+    std::string impl;
+    std::string pointers;
+    std::string input;
+    unsigned int vlen;
+    unsigned int calls; // per repetition
+    std::vector<double> ns; // per call, one entry per repetition
+    double median_ns;
+    double min_ns;
+};
+
+std::vector<std::string> split(const std::string& text)
+{
+    std::vector<std::string> fields;
+    std::istringstream stream(text);
+    std::string field;
+    while (std::getline(stream, field, ',')) {
+        if (!field.empty()) {
+            fields.push_back(field);
+        }
+    }
+    return fields;
+}
+
+bool parse_lengths(const std::string& text, std::vector<unsigned int>& lengths)
+{
+    lengths.clear();
+    for (const auto& field : split(text)) {
+        char* end = nullptr;
+        unsigned long length = std::strtoul(field.c_str(), &end, 10);
+        if (*end == 'k' || *end == 'K') {
+            length <<= 10;
+            end++;
+        } else if (*end == 'm' || *end == 'M') {
+            length <<= 20;
+            end++;
+        }
+        if (end == field.c_str() || *end != '\0' || length == 0) {
+            return false;
+        }
+        lengths.push_back((unsigned int)length);
+    }
+    return !lengths.empty();
+}
+
+bool parse_pointer_modes(const std::string& text, std::vector<pointer_mode>& modes)
+{
+    modes.clear();
+    for (const auto& field : split(text)) {
+        if (field == "aligned") {
+            modes.push_back({ field, 0 });
+        } else if (field == "unaligned") {
+            modes.push_back({ field, 1 });
+        } else if (field.compare(0, 7, "offset:") == 0) {
+            char* end = nullptr;
+            const unsigned long offset = std::strtoul(field.c_str() + 7, &end, 10);
+            if (end == field.c_str() + 7 || *end != '\0') {
+                return false;
+            }
+            modes.push_back({ field, (unsigned int)offset });
+        } else {
+            return false;
+        }
+    }
+    return !modes.empty();
+}
+
+double elapsed_ns(bench_clock::time_point start, bench_clock::time_point stop)
+{
+    return std::chrono::duration<double, std::nano>(stop - start).count();
+}
+
+bench_result time_impl(const volk_bench_call_t& call, const char* impl_name)
+{
+    call(impl_name); // warm up, and an estimate of the calls per repetition
+    auto start = bench_clock::now();
+    call(impl_name);
+    const double estimate = std::max(elapsed_ns(start, bench_clock::now()), 1.0);
+
+    bench_result result;
+    result.calls =
+        (unsigned int)std::min(std::max(1e6 * min_time_ms / estimate, 1.0), 1e6);
+    for (int rep = 0; rep < repetitions; rep++) {
+        start = bench_clock::now();
+        for (unsigned int ii = 0; ii < result.calls; ii++) {
+            call(impl_name);
+        }
+        result.ns.push_back(elapsed_ns(start, bench_clock::now()) / result.calls);
+    }
+    std::vector<double> sorted(result.ns);
+    std::sort(sorted.begin(), sorted.end());
+    result.median_ns = sorted[sorted.size() / 2];
+    result.min_ns = sorted.front();
+    return result;
+}
+
+void write_json(const std::vector<bench_result>& results)
+{
+    std::ofstream json(json_filename);
+    json << "{" << std::endl << " \"volk_bench\": [" << std::endl;
+    for (size_t ii = 0; ii < results.size(); ii++) {
+        const bench_result& result = results[ii];
+        json << "  {\"kernel\": \"" << result.kernel << "\", \"impl\": \"" << result.impl
+             << "\", \"pointers\": \"" << result.pointers << "\", \"input\": \""
+             << result.input << "\", \"vlen\": "
+             << result.vlen << ", \"calls\": " << result.calls << ", \"ns\": [";
+        for (size_t rep = 0; rep < result.ns.size(); rep++) {
+            json << (rep ? ", " : "") << result.ns[rep];
+        }
+        json << "], \"median_ns\": " << result.median_ns
+             << ", \"min_ns\": " << result.min_ns
+             << ", \"points_per_ns\": " << result.vlen / result.median_ns << "}"
+             << (ii + 1 < results.size() ? "," : "") << std::endl;
+    }
+    json << " ]" << std::endl << "}" << std::endl;
+}
+
+void write_csv(const std::vector<bench_result>& results)
+{
+    std::ofstream csv(csv_filename);
+    csv << "kernel,impl,pointers,input,vlen,calls,repetitions,median_ns,min_ns,"
+           "points_per_ns"
+        << std::endl;
+    for (const auto& result : results) {
+        csv << result.kernel << "," << result.impl << "," << result.pointers << ","
+            << result.input << "," << result.vlen << "," << result.calls << ","
+            << result.ns.size() << "," << result.median_ns << "," << result.min_ns
+            << "," << result.vlen / result.median_ns << std::endl;
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    option_list bench_options("volk_bench");
+    bench_options.add(option_t(
+        "filter", "R", "Run the kernels whose name matches this regex", set_filter));
+    bench_options.add(option_t("vlen",
+                               "v",
+                               "Comma separated vector lengths, k and M suffixes allowed",
+                               set_vlen));
+    bench_options.add(option_t("case-vlen",
+                               "V",
+                               "Vector lengths of one kernel as kernel=lengths, may be "
+                               "given once per kernel",
+                               set_case_vlen));
+    bench_options.add(option_t(
+        "repetitions", "r", "Timed repetitions of every measurement", set_repetitions));
+    bench_options.add(option_t(
+        "min-time", "t", "Milliseconds each repetition runs at least", set_min_time));
+    bench_options.add(option_t("pointers",
+                               "p",
+                               "Comma separated pointer modes: aligned, unaligned "
+                               "(one element off) and offset:N (N elements off)",
+                               set_pointers));
+    bench_options.add(option_t("input",
+                               "d",
+                               "Fill the vectors with one of " + volk_test_input_names(),
+                               set_input));
+    bench_options.add(option_t("impls",
+                               "I",
+                               "Implementations to time: all, dispatch or a comma "
+                               "separated list of names",
+                               set_impls));
+    bench_options.add(option_t("list", "l", "List the kernels and exit", set_list));
+    bench_options.add(
+        option_t("json", "j", "Write the results to this JSON file", set_json));
+    bench_options.add(
+        option_t("csv", "C", "Write the results to this CSV file", set_csv));
+    try {
+        bench_options.parse(argc, argv);
+    } catch (...) {
+        return 1;
+    }
+    if (bench_options.present("help")) {
+        return 0;
+    }
+
+    std::vector<unsigned int> default_lengths;
+    std::vector<pointer_mode> modes;
+    if (!parse_lengths(vlen_list, default_lengths)) {
+        std::cerr << "Invalid vector lengths " << vlen_list << std::endl;
+        return 1;
+    }
+    if (!parse_pointer_modes(pointer_modes, modes)) {
+        std::cerr << "Invalid pointer modes " << pointer_modes << std::endl;
+        return 1;
+    }
+    volk_test_input_t input;
+    if (!volk_test_input_from_string(input_name, input)) {
+        std::cerr << "Invalid input distribution " << input_name << ", expected one of "
+                  << volk_test_input_names() << std::endl;
+        return 1;
+    }
+    std::regex filter(case_filter);
+
+    if (list_cases) {
+        for (const auto& bench_case : volk_bench_cases) {
+            if (std::regex_search(bench_case.name, filter)) {
+                std::cout << bench_case.name << std::endl;
+            }
+        }
+        for (const auto& skipped : volk_bench_skipped) {
+            if (std::regex_search(skipped.first, filter)) {
+                std::cout << skipped.first << " (skipped: " << skipped.second << ")"
+                          << std::endl;
+            }
+        }
+        return 0;
+    }
+
+    const std::vector<std::string> selected_impls = split(impl_selection);
+    std::vector<bench_result> results;
+    std::cout << std::setw(48) << std::left << "kernel" << std::setw(20) << "impl"
+              << std::setw(12) << "pointers" << std::right << std::setw(10) << "vlen"
+              << std::setw(14) << "median ns" << std::setw(14) << "min ns"
+              << std::setw(12) << "points/ns" << std::endl;
+    for (const auto& bench_case : volk_bench_cases) {
+        if (!std::regex_search(bench_case.name, filter)) {
+            continue;
+        }
+        std::vector<unsigned int> lengths = default_lengths;
+        const auto case_lengths = case_vlen_lists.find(bench_case.name);
+        if (case_lengths != case_vlen_lists.end() &&
+            !parse_lengths(case_lengths->second, lengths)) {
+            std::cerr << "Invalid vector lengths " << case_lengths->second << " for "
+                      << bench_case.name << std::endl;
+            return 1;
+        }
+
+        const volk_func_desc_t desc = bench_case.desc();
+        for (const auto& mode : modes) {
+            for (unsigned int vlen : lengths) {
+                volk_bench_args args(vlen, mode.offset, input);
+                const volk_bench_call_t call = bench_case.bind(args, vlen);
+
+                // the dispatcher is timed under a null implementation name
+                std::vector<const char*> impls;
+                if (impl_selection == "all" || impl_selection == "dispatch") {
+                    impls.push_back(nullptr);
+                }
+                for (size_t ii = 0; ii < desc.n_impls; ii++) {
+                    const bool selected =
+                        impl_selection == "all" ||
+                        std::find(selected_impls.begin(),
+                                  selected_impls.end(),
+                                  desc.impl_names[ii]) != selected_impls.end();
+                    if (selected && (args.aligned() || !desc.impl_alignment[ii])) {
+                        impls.push_back(desc.impl_names[ii]);
+                    }
+                }
+
+                for (const char* impl_name : impls) {
+                    bench_result result = time_impl(call, impl_name);
+                    result.kernel = bench_case.name;
+                    result.impl = impl_name ? impl_name : "dispatch";
+                    result.pointers = mode.name;
+                    result.input = input_name;
+                    result.vlen = vlen;
+                    std::cout << std::setw(48) << std::left << result.kernel
+                              << std::setw(20) << result.impl << std::setw(12)
+                              << result.pointers << std::right << std::setw(10)
+                              << result.vlen << std::setw(14) << result.median_ns
+                              << std::setw(14) << result.min_ns << std::setw(12)
+                              << result.vlen / result.median_ns << std::endl;
+                    results.push_back(result);
+                }
+            }
+        }
+    }
+
+    if (!json_filename.empty()) {
+        write_json(results);
+    }
+    if (!csv_filename.empty()) {
+        write_csv(results);
+    }
+    return 0;
+}
@@ -0,0 +1,130 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of VOLK
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef VOLK_VOLK_BENCH_H
+#define VOLK_VOLK_BENCH_H
+
+#include <volk/volk.h>        // for volk_func_desc_t, volk_is_aligned
+#include <volk/volk_malloc.h> // for volk_malloc, volk_free
+#include <complex>            // for complex
+#include <functional>         // for function
+#include <type_traits>        // for is_floating_point, is_signed
+#include <utility>            // for pair
+#include <vector>             // for vector
+
+#include "qa_utils.h" // for volk_type_t, volk_test_input_t, load_random_data
+
+template <typename T>
+struct volk_bench_element {
+    static const bool is_complex = false;
+    static volk_type_t type()
+    {
+        volk_type_t type;
+        type.is_float = std::is_floating_point<T>::value;
+        type.is_scalar = false;
+        type.is_signed = std::is_signed<T>::value;
+        type.is_complex = false;
+        type.size = sizeof(T);
+        return type;
+    }
+};
+
+template <typename T>
+struct volk_bench_element<std::complex<T>> {
+    static const bool is_complex = true;
+    static volk_type_t type()
+    {
+        volk_type_t type = volk_bench_element<T>::type();
+        type.is_complex = true;
+        return type;
+    }
+};
+
+/*
+ * The arguments of one benchmark case. Every vector holds random data from
+ * the chosen input distribution as in the QA tests and starts offset
+ * elements into its allocation. A few elements of padding keep kernels
+ * that read a fixed number of elements, like polynomial coefficients,
+ * inside their buffers at short lengths.
+ * Real scalars count up from 1.5 so that pairs of bounds make a range,
+ * complex ones have unit magnitude so that rotations stay bounded.
+ */
+class volk_bench_args
+{
+public:
+    volk_bench_args(unsigned int num_points,
+                    unsigned int offset,
+                    volk_test_input_t input = VOLK_TEST_INPUT_UNIFORM)
+        : _num_points(num_points),
+          _offset(offset),
+          _input(input),
+          _scalars(0),
+          _aligned(true)
+    {
+    }
+    ~volk_bench_args()
+    {
+        for (void* allocation : _allocations) {
+            volk_free(allocation);
+        }
+    }
+    volk_bench_args(const volk_bench_args&) = delete;
+    volk_bench_args& operator=(const volk_bench_args&) = delete;
+
+    template <typename T>
+    T* vector()
+    {
+        const size_t n = _num_points + _offset + padding;
+        T* allocation = (T*)volk_malloc(n * sizeof(T), volk_get_alignment());
+        _allocations.push_back(allocation);
+        load_random_data(allocation, volk_bench_element<T>::type(), n, _input);
+        T* vector = allocation + _offset;
+        _aligned = _aligned && volk_is_aligned(vector);
+        return vector;
+    }
+
+    template <typename T>
+    T scalar()
+    {
+        _scalars++;
+        if constexpr (volk_bench_element<T>::is_complex) {
+            return T(0.6f, 0.8f);
+        } else {
+            return T(1.5 * _scalars);
+        }
+    }
+
+    //! true when every vector is aligned for the a_ implementations
+    bool aligned() const { return _aligned; }
+
+private:
+    static const unsigned int padding = 16;
+    unsigned int _num_points;
+    unsigned int _offset;
+    volk_test_input_t _input;
+    unsigned int _scalars;
+    bool _aligned;
+    std::vector<void*> _allocations;
+};
+
+//! a kernel call bound to its arguments, a null impl_name calls the dispatcher
+typedef std::function<void(const char* impl_name)> volk_bench_call_t;
+
+struct volk_bench_case_t {
+    const char* name;
+    volk_func_desc_t (*desc)(void);
+    volk_bench_call_t (*bind)(volk_bench_args& args, unsigned int num_points);
+};
+
+//! one case per kernel, generated from the kernel headers by volk_bench_cases.tmpl.cc
+extern const std::vector<volk_bench_case_t> volk_bench_cases;
+//! kernels without a generated case, with the reason
+extern const std::vector<std::pair<const char*, const char*>> volk_bench_skipped;
+
+#endif // VOLK_VOLK_BENCH_H
@@ -0,0 +1,100 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of VOLK
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include <volk/volk.h>            // for volk_can_flush_denormals
+#include <volk/volk_denormals.hh> // for flush_denormals
+#include <algorithm>              // for max
+#include <iomanip>                // for setw, setprecision
+#include <iostream>               // for cout
+#include <map>                    // for map
+#include <string>                 // for string
+
+#include "volk_denormal_penalty.h"
+
+namespace {
+
+// per arch, the median call time of a run over that of the baseline
+std::map<std::string, double> penalties(const volk_test_results_t& run,
+                                        const volk_test_results_t& baseline)
+{
+    std::map<std::string, double> ratios;
+    for (const auto& arch_time : run.results) {
+        const auto base = baseline.results.find(arch_time.first);
+        if (base == baseline.results.end() || !arch_time.second.pass ||
+            !base->second.pass || base->second.median <= 0.0) {
+            continue;
+        }
+        ratios[arch_time.first] = arch_time.second.median / base->second.median;
+    }
+    return ratios;
+}
+
+volk_test_results_t run_inputs(volk_test_case_t& test_case,
+                               volk_test_input_t input,
+                               bool flush)
+{
+    volk_test_params_t params = test_case.test_parameters();
+    params.set_input(input);
+    std::cout << "Denormal penalty: " << volk_test_input_name(input)
+              << (flush ? " inputs, flushed to zero" : " inputs") << std::endl;
+
+    volk::flush_denormals mode(flush);
+    std::vector<volk_test_results_t> run_results;
+    run_volk_tests(test_case.desc(),
+                   test_case.kernel_ptr(),
+                   test_case.name(),
+                   params,
+                   &run_results,
+                   test_case.puppet_master_name());
+    return run_results.back();
+}
+
+} // namespace
+
+void run_denormal_penalty(volk_test_case_t test_case,
+                          std::vector<volk_test_results_t>* results)
+{
+    // the chosen inputs are the baseline, unless they are denormal themselves
+    volk_test_input_t usual = test_case.test_parameters().input();
+    if (usual == VOLK_TEST_INPUT_DENORMAL) {
+        usual = VOLK_TEST_INPUT_UNIFORM;
+    }
+    volk_test_results_t baseline = run_inputs(test_case, usual, false);
+    if (baseline.results.empty()) {
+        return;
+    }
+    const volk_test_results_t denormal =
+        run_inputs(test_case, VOLK_TEST_INPUT_DENORMAL, false);
+    baseline.denormal_penalty = penalties(denormal, baseline);
+    if (volk_can_flush_denormals()) {
+        const volk_test_results_t flushed =
+            run_inputs(test_case, VOLK_TEST_INPUT_DENORMAL, true);
+        baseline.flushed_penalty = penalties(flushed, baseline);
+    }
+
+    std::cout << "Slowdown of " << test_case.name() << " on denormal inputs:"
+              << std::endl;
+    std::cout << std::setw(20) << "arch" << std::setw(12) << "denormal" << std::setw(12)
+              << "flushed" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    for (const auto& arch : baseline.denormal_penalty) {
+        std::cout << std::setw(20) << arch.first << std::setw(12) << arch.second;
+        const auto flushed = baseline.flushed_penalty.find(arch.first);
+        if (flushed != baseline.flushed_penalty.end()) {
+            std::cout << std::setw(12) << flushed->second;
+        } else {
+            std::cout << std::setw(12) << "-";
+        }
+        std::cout << std::endl;
+    }
+    std::cout.unsetf(std::ios_base::floatfield);
+    std::cout << std::setprecision(6);
+
+    results->push_back(baseline);
+}
@@ -0,0 +1,27 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of VOLK
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef VOLK_VOLK_DENORMAL_PENALTY_H
+#define VOLK_VOLK_DENORMAL_PENALTY_H
+
+#include <vector> // for vector
+
+#include "qa_utils.h" // for volk_test_case_t, volk_test_results_t
+
+/*
+ * Profile a kernel on its usual inputs, on denormal inputs, and on
+ * denormal inputs with denormals flushed to zero where the platform
+ * allows it. Prints how many times slower each implementation runs on
+ * denormals, and appends the result of the usual inputs, whose ranking
+ * is written, with those penalties.
+ */
+void run_denormal_penalty(volk_test_case_t test_case,
+                          std::vector<volk_test_results_t>* results);
+
+#endif // VOLK_VOLK_DENORMAL_PENALTY_H
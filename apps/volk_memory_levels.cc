@@ -0,0 +1,179 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of VOLK
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include <volk/volk.h> // for volk_get_cache_sizes
+#include <algorithm>   // for max, min
+#include <chrono>      // for steady_clock
+#include <iomanip>     // for setw, setprecision
+#include <iostream>    // for cout
+#include <sstream>     // for istringstream, ostringstream
+
+#include "volk_memory_levels.h"
+#include "volk_ticks.h" // for volk_ticks
+
+namespace {
+
+const char* const all_levels[] = { "l1", "l2", "llc", "dram" };
+
+// caches are not allocated more than this per buffer set, nor dram in total
+const size_t max_cache_working_set = 64 << 20;
+const size_t max_dram_footprint = 256 << 20;
+
+void cache_sizes(size_t& l1, size_t& l2, size_t& llc)
+{
+    volk_get_cache_sizes(&l1, &l2, &llc);
+    static bool reported = false;
+    if (!reported) {
+        std::cout << "Data caches: L1 " << l1 << ", L2 " << l2 << ", LLC " << llc
+                  << " bytes" << std::endl;
+        reported = true;
+    }
+    // typical sizes where the host does not tell
+    l1 = l1 ? l1 : 32 << 10;
+    l2 = l2 ? l2 : 1 << 20;
+    llc = llc ? llc : 8 << 20;
+}
+
+// time stamp counter ticks per nanosecond, measured once
+double ticks_per_ns()
+{
+    static double rate = 0.0;
+    if (rate == 0.0) {
+        const auto start = std::chrono::steady_clock::now();
+        const uint64_t start_ticks = volk_ticks();
+        auto now = start;
+        while (now - start < std::chrono::milliseconds(20)) {
+            now = std::chrono::steady_clock::now();
+        }
+        const double ns = std::chrono::duration<double, std::nano>(now - start).count();
+        rate = (volk_ticks() - start_ticks) / ns;
+    }
+    return rate;
+}
+
+} // namespace
+
+bool parse_memory_levels(const std::string& spec, std::vector<std::string>& levels)
+{
+    levels.clear();
+    if (spec == "all") {
+        levels.assign(std::begin(all_levels), std::end(all_levels));
+        return true;
+    }
+    std::istringstream level_list(spec);
+    std::string level;
+    while (std::getline(level_list, level, ',')) {
+        if (std::find(std::begin(all_levels), std::end(all_levels), level) ==
+            std::end(all_levels)) {
+            return false;
+        }
+        levels.push_back(level);
+    }
+    return !levels.empty();
+}
+
+void run_memory_levels(volk_test_case_t test_case,
+                       const std::vector<std::string>& levels,
+                       const std::string& rank_level,
+                       std::vector<volk_test_results_t>* results)
+{
+    size_t l1, l2, llc;
+    cache_sizes(l1, l2, llc);
+    const size_t bytes_per_point = volk_test_bytes_per_point(test_case.name());
+    volk_test_params_t params = test_case.test_parameters();
+    const double points = (double)params.vlen() * params.iter();
+    const double max_iter = 16.0 * params.iter();
+
+    volk_test_results_t ranked_result;
+    std::vector<volk_test_memory_level_t> measured;
+    for (const auto& level : levels) {
+        unsigned int vlen = params.vlen();
+        unsigned int buffer_sets = 1;
+        if (level == "dram") {
+            // calls of the usual length, on data pushed out by the other sets
+            const size_t footprint =
+                std::min(std::max(4 * llc, (size_t)64 << 20), max_dram_footprint);
+            buffer_sets = std::max<size_t>(2, footprint / (vlen * bytes_per_point) + 1);
+        } else {
+            const size_t cache = level == "l1" ? l1 : level == "l2" ? l2 : llc;
+            const size_t working_set = std::min(cache / 2, max_cache_working_set);
+            vlen = std::max<size_t>(16, working_set / bytes_per_point);
+        }
+        const double sample_points = std::max(vlen, 1024u);
+        const double iter = std::max(std::min(points / sample_points, max_iter), 16.0);
+
+        volk_test_params_t level_params = params;
+        level_params.set_vlen(vlen);
+        level_params.set_iter((unsigned int)iter);
+        level_params.set_buffer_sets(buffer_sets);
+        std::cout << "Memory level " << level << ": vlen " << vlen << ", "
+                  << buffer_sets << " buffer sets" << std::endl;
+
+        std::vector<volk_test_results_t> level_results;
+        run_volk_tests(test_case.desc(),
+                       test_case.kernel_ptr(),
+                       test_case.name(),
+                       level_params,
+                       &level_results,
+                       test_case.puppet_master_name());
+        const volk_test_results_t& result = level_results.back();
+        if (result.results.empty()) {
+            return; // nothing to compare at any level
+        }
+
+        volk_test_memory_level_t entry;
+        entry.level = level;
+        entry.vlen = vlen;
+        entry.buffer_sets = buffer_sets;
+        entry.best_arch_a = result.best_arch_a;
+        entry.best_arch_u = result.best_arch_u;
+        for (const auto& arch_time : result.results) {
+            const double ns = 1e6 * arch_time.second.median;
+            if (arch_time.second.pass && ns > 0.0) {
+                entry.gb_per_s[arch_time.first] = (double)vlen * bytes_per_point / ns;
+                entry.elements_per_cycle[arch_time.first] = vlen / (ns * ticks_per_ns());
+            }
+        }
+        measured.push_back(entry);
+        if (level == rank_level) {
+            ranked_result = result;
+        }
+    }
+
+    std::cout << "GB/s and elements/cycle of " << test_case.name() << ":" << std::endl;
+    std::cout << std::setw(6) << "level";
+    for (const auto& arch : measured.front().gb_per_s) {
+        std::cout << std::setw(std::max<size_t>(16, arch.first.size() + 2)) << arch.first;
+    }
+    std::cout << std::endl << std::fixed << std::setprecision(2);
+    for (const auto& entry : measured) {
+        std::cout << std::setw(6) << entry.level;
+        for (const auto& arch : measured.front().gb_per_s) {
+            std::ostringstream cell;
+            cell << std::fixed << std::setprecision(2);
+            if (entry.gb_per_s.count(arch.first)) {
+                cell << entry.gb_per_s.at(arch.first) << "/"
+                     << entry.elements_per_cycle.at(arch.first);
+            } else {
+                cell << "-";
+            }
+            std::cout << std::setw(std::max<size_t>(16, arch.first.size() + 2))
+                      << cell.str();
+        }
+        std::cout << "  best " << entry.best_arch_a << ", " << entry.best_arch_u
+                  << std::endl;
+    }
+    std::cout.unsetf(std::ios_base::floatfield);
+    std::cout << std::setprecision(6);
+    std::cout << "Ranked by " << rank_level << ": " << ranked_result.best_arch_a
+              << " aligned, " << ranked_result.best_arch_u << " unaligned" << std::endl;
+
+    ranked_result.memory_levels = measured;
+    results->push_back(ranked_result);
+}
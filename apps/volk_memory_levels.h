@@ -0,0 +1,38 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of VOLK
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef VOLK_VOLK_MEMORY_LEVELS_H
+#define VOLK_VOLK_MEMORY_LEVELS_H
+
+#include <string> // for string
+#include <vector> // for vector
+
+#include "qa_utils.h" // for volk_test_case_t, volk_test_results_t
+
+/*
+ * Parse a comma separated list of the memory levels l1, l2, llc and dram,
+ * or "all" for every one of them. Returns false on unknown levels.
+ */
+bool parse_memory_levels(const std::string& spec, std::vector<std::string>& levels);
+
+/*
+ * Profile a kernel with its data in each memory level. The working set of
+ * a cache level is half its size as reported by volk_get_cache_sizes. For
+ * dram the timed calls rotate through copies of the buffers several times
+ * larger than the last level cache, so every call starts with cold data.
+ * Prints GB/s and elements per time stamp counter cycle of every
+ * implementation per level, and appends one result whose best
+ * implementations are those of rank_level.
+ */
+void run_memory_levels(volk_test_case_t test_case,
+                       const std::vector<std::string>& levels,
+                       const std::string& rank_level,
+                       std::vector<volk_test_results_t>* results);
+
+#endif // VOLK_VOLK_MEMORY_LEVELS_H
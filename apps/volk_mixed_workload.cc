@@ -0,0 +1,163 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of VOLK
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include <stdint.h>            // for uint64_t
+#include <stdio.h>             // for popen, pclose, fgets
+#include <volk/volk.h>         // for volk_32fc_x2_multiply_32fc, ...
+#include <volk/volk_alloc.hh>  // for volk::vector
+#include <algorithm>           // for max
+#include <atomic>              // for atomic
+#include <chrono>              // for steady_clock
+#include <iomanip>             // for setw
+#include <iostream>            // for cout, cerr
+#include <sstream>             // for istringstream
+#include <thread>              // for thread
+#include <vector>              // for vector
+
+#include "volk_mixed_workload.h"
+
+#if defined(_WIN32)
+#define popen _popen
+#define pclose _pclose
+#endif
+
+namespace {
+
+const unsigned int vector_points = 4096;
+const unsigned int scalar_steps = 20000;
+
+// branchy integer work standing in for the non VOLK code of a flowgraph
+uint64_t scalar_work(uint64_t state)
+{
+    uint64_t acc = 0;
+    for (unsigned int ii = 0; ii < scalar_steps; ++ii) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        if (state & 1) {
+            acc += state % 7;
+        } else {
+            acc -= state % 3;
+        }
+    }
+    return acc + state;
+}
+
+} // namespace
+
+double run_mixed_workload(unsigned int n_threads, double seconds)
+{
+    n_threads = std::max(n_threads, 1u);
+    std::atomic<uint64_t> rounds(0);
+    std::atomic<uint64_t> sink(0);
+    std::atomic<bool> go(false);
+    auto deadline = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> workers;
+    for (unsigned int tt = 0; tt < n_threads; ++tt) {
+        workers.emplace_back([&, tt]() {
+            volk::vector<lv_32fc_t> in0(vector_points, lv_cmake(0.5f, -0.25f));
+            volk::vector<lv_32fc_t> in1(vector_points, lv_cmake(0.75f, 0.125f));
+            volk::vector<lv_32fc_t> product(vector_points);
+            volk::vector<float> magnitude(vector_points);
+            volk::vector<float> sum(vector_points);
+            uint64_t state = 0x9e3779b97f4a7c15ULL + tt;
+            uint64_t local_rounds = 0;
+            while (!go.load(std::memory_order_acquire)) {
+            }
+            while (std::chrono::steady_clock::now() < deadline) {
+                volk_32fc_x2_multiply_32fc(
+                    product.data(), in0.data(), in1.data(), vector_points);
+                volk_32fc_magnitude_32f(magnitude.data(), product.data(), vector_points);
+                volk_32f_x2_add_32f(
+                    sum.data(), magnitude.data(), magnitude.data(), vector_points);
+                volk_32f_s32f_multiply_32f(
+                    magnitude.data(), sum.data(), 0.5f, vector_points);
+                state = scalar_work(state);
+                ++local_rounds;
+            }
+            rounds += local_rounds;
+            sink += state + (uint64_t)magnitude[0];
+        });
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    deadline = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                           std::chrono::duration<double>(seconds));
+    go.store(true, std::memory_order_release);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    double elapsed =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return rounds.load() / elapsed;
+}
+
+int compare_machine_selections(const std::string& argv0, const std::string& selections)
+{
+    struct outcome {
+        std::string selection;
+        std::string machine;
+        double rate;
+    };
+    std::vector<outcome> outcomes;
+
+    std::istringstream selection_list(selections);
+    std::string selection;
+    while (std::getline(selection_list, selection, ',')) {
+        if (selection.empty()) {
+            continue;
+        }
+        std::string command =
+            "\"" + argv0 + "\" --mixed-workload-child \"" + selection + "\"";
+        FILE* child = popen(command.c_str(), "r");
+        if (!child) {
+            std::cerr << "Cannot run " << command << std::endl;
+            return 1;
+        }
+        // the child reports "<machine> <rounds per second>" on its last line
+        char line[256];
+        std::string last_line;
+        while (fgets(line, sizeof(line), child)) {
+            if (line[0] != '\n') {
+                last_line = line;
+            }
+        }
+        if (pclose(child) != 0) {
+            std::cerr << "Selection " << selection << " matches no machine, skipped"
+                      << std::endl;
+            continue;
+        }
+        outcome result;
+        result.selection = selection;
+        std::istringstream fields(last_line);
+        if (fields >> result.machine >> result.rate) {
+            outcomes.push_back(result);
+        }
+    }
+
+    if (outcomes.empty()) {
+        std::cerr << "No machine selection could be measured" << std::endl;
+        return 1;
+    }
+
+    const outcome* best = &outcomes[0];
+    std::cout << std::left << std::setw(24) << "selection" << std::setw(24) << "machine"
+              << "rounds/s" << std::endl;
+    for (const auto& result : outcomes) {
+        std::cout << std::setw(24) << result.selection << std::setw(24) << result.machine
+                  << result.rate << std::endl;
+        if (result.rate > best->rate) {
+            best = &result;
+        }
+    }
+    std::cout << "Best selection: " << best->selection
+              << " (use VOLK_MACHINE=" << best->selection << ")" << std::endl;
+    return 0;
+}
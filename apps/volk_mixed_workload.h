@@ -0,0 +1,31 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of VOLK
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef VOLK_VOLK_MIXED_WORKLOAD_H
+#define VOLK_VOLK_MIXED_WORKLOAD_H
+
+#include <string> // for string
+
+/*
+ * Whole machine throughput of a workload that interleaves VOLK kernels
+ * with branchy scalar code on every hardware thread, in rounds per
+ * second. Wide vector units may lower the clock for the scalar part as
+ * well, which single kernel timings do not show.
+ */
+double run_mixed_workload(unsigned int n_threads, double seconds);
+
+/*
+ * Run the mixed workload once per machine selection, each in a fresh
+ * process started from argv0 since the machine is fixed per process,
+ * and print which selection (see volk_set_machine) did best.
+ * selections is a comma separated list, e.g. "max-caps,prefer-no-avx512".
+ */
+int compare_machine_selections(const std::string& argv0, const std::string& selections);
+
+#endif // VOLK_VOLK_MIXED_WORKLOAD_H
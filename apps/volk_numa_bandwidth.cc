@@ -0,0 +1,112 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of VOLK
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include <volk/volk_malloc.h> // for volk_get_numa_node, volk_get_numa_nodes
+#include <algorithm>          // for max
+#include <iomanip>            // for setw, setprecision
+#include <iostream>           // for cout
+#include <string>             // for string, to_string
+
+#include "volk_memory_levels.h" // for run_memory_levels
+#include "volk_numa_bandwidth.h"
+
+#if HAS_STD_FILESYSTEM_EXPERIMENTAL
+#include <experimental/filesystem>
+namespace fs = std::experimental::filesystem;
+#else
+#include <filesystem>
+namespace fs = std::filesystem;
+#endif
+
+namespace {
+
+// the node sysfs lists the CPU under, 0 if it does not tell
+int node_of_cpu(int cpu)
+{
+    const std::string cpu_dir = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+    for (int node = 0; node < volk_get_numa_nodes(); node++) {
+        std::error_code error;
+        if (fs::exists(cpu_dir + "/node" + std::to_string(node), error)) {
+            return node;
+        }
+    }
+    return 0;
+}
+
+volk_test_memory_level_t run_on_node(volk_test_case_t& test_case,
+                                     volk_test_params_t params,
+                                     int node,
+                                     volk_test_results_t& ranked_result)
+{
+    params.set_mem_node(node);
+    volk_test_case_t node_case(test_case.desc(),
+                               test_case.kernel_ptr(),
+                               test_case.name(),
+                               test_case.puppet_master_name(),
+                               params);
+    std::cout << "NUMA node " << node << ":" << std::endl;
+    std::vector<volk_test_results_t> node_results;
+    run_memory_levels(node_case, { "dram" }, "dram", &node_results);
+    if (node_results.empty() || node_results.back().memory_levels.empty()) {
+        return volk_test_memory_level_t();
+    }
+    ranked_result = node_results.back();
+    return ranked_result.memory_levels.front();
+}
+
+} // namespace
+
+void run_numa_bandwidth(volk_test_case_t test_case,
+                        std::vector<volk_test_results_t>* results)
+{
+    volk_test_params_t params = test_case.test_parameters();
+    int cpu = params.pin_cpu();
+    if (cpu < 0) {
+        volk_get_numa_node(&cpu);
+        params.set_pin_cpu(cpu);
+    }
+    const int local_node = cpu < 0 ? 0 : node_of_cpu(cpu);
+    const int remote_node = (local_node + 1) % volk_get_numa_nodes();
+
+    volk_test_results_t local_result, remote_result;
+    const volk_test_memory_level_t local =
+        run_on_node(test_case, params, local_node, local_result);
+    if (local.gb_per_s.empty()) {
+        return;
+    }
+    const volk_test_memory_level_t remote =
+        run_on_node(test_case, params, remote_node, remote_result);
+
+    std::cout << "GB/s of " << test_case.name() << " on CPU " << cpu << ":" << std::endl;
+    std::cout << std::setw(20) << "arch" << std::setw(12)
+              << ("node " + std::to_string(local_node)) << std::setw(12)
+              << ("node " + std::to_string(remote_node)) << std::setw(12)
+              << "remote/local" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    for (const auto& arch : local.gb_per_s) {
+        std::cout << std::setw(20) << arch.first << std::setw(12) << arch.second;
+        const auto other = remote.gb_per_s.find(arch.first);
+        if (other != remote.gb_per_s.end() && arch.second > 0.0) {
+            std::cout << std::setw(12) << other->second << std::setw(12)
+                      << other->second / arch.second;
+        } else {
+            std::cout << std::setw(12) << "-" << std::setw(12) << "-";
+        }
+        std::cout << std::endl;
+    }
+    std::cout.unsetf(std::ios_base::floatfield);
+    std::cout << std::setprecision(6);
+
+    local_result.memory_levels.clear();
+    local_result.local_node = local_node;
+    local_result.remote_node = remote_node;
+    local_result.local_gb_per_s = local.gb_per_s;
+    local_result.remote_gb_per_s = remote.gb_per_s;
+    results->push_back(local_result);
+}
@@ -0,0 +1,27 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of VOLK
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef VOLK_VOLK_NUMA_BANDWIDTH_H
+#define VOLK_VOLK_NUMA_BANDWIDTH_H
+
+#include <vector> // for vector
+
+#include "qa_utils.h" // for volk_test_case_t, volk_test_results_t
+
+/*
+ * Profile a kernel with its data out of the caches, once with the buffers
+ * on the NUMA node of the timing thread and once on the next node. The
+ * timing thread is pinned to the CPU it starts on unless --pin-cpu chose
+ * one. Prints GB/s of every implementation for both nodes and appends the
+ * result of the local run, whose ranking is written, with both figures.
+ */
+void run_numa_bandwidth(volk_test_case_t test_case,
+                        std::vector<volk_test_results_t>* results);
+
+#endif // VOLK_VOLK_NUMA_BANDWIDTH_H
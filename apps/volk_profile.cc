@@ -14,18 +14,27 @@
 #endif
 #include <stddef.h>          // for size_t
 #include <sys/stat.h>        // for stat
+#include <volk/volk.h>       // for volk_get_cpu_fingerprint
 #include <volk/volk_prefs.h> // for volk_get_config_path
+#include <algorithm>         // for find
 #include <fstream>           // IWYU pragma: keep
 #include <iostream>          // for operator<<, basic_ostream
 #include <map>               // for map, map<>::iterator
+#include <sstream>           // for istringstream
+#include <thread>            // for thread
 #include <utility>           // for pair
 #include <vector>            // for vector, vector<>::const_...
 
-#include "kernel_tests.h"        // for init_test_list
-#include "qa_utils.h"            // for volk_test_results_t, vol...
-#include "volk/volk_complex.h"   // for lv_32fc_t
-#include "volk_option_helpers.h" // for option_list, option_t
+#include "kernel_tests.h"          // for init_test_list
+#include "qa_utils.h"              // for volk_test_results_t, vol...
+#include "volk/volk_complex.h"     // for lv_32fc_t
+#include "volk_denormal_penalty.h" // for run_denormal_penalty
+#include "volk_memory_levels.h"    // for parse_memory_levels, run_memory_levels
+#include "volk_mixed_workload.h"   // for run_mixed_workload, compare_machine...
+#include "volk_numa_bandwidth.h"   // for run_numa_bandwidth
+#include "volk_option_helpers.h"   // for option_list, option_t
 #include "volk_profile.h"
+#include "volk_vlen_sweep.h"       // for parse_vlen_sweep, run_vlen_sweep, ...
 
 #if HAS_STD_FILESYSTEM_EXPERIMENTAL
 namespace fs = std::experimental::filesystem;
@@ -39,6 +48,24 @@ void set_benchmark(bool val) { test_params.set_benchmark(val); }
 void set_tolerance(float val) { test_params.set_tol(val); }
 void set_vlen(int val) { test_params.set_vlen((unsigned int)val); }
 void set_iter(int val) { test_params.set_iter((unsigned int)val); }
+void set_warmup(int val) { test_params.set_warmup((unsigned int)val); }
+void set_pin_cpu(int val) { test_params.set_pin_cpu(val); }
+void set_perf_counters(bool val) { test_params.set_perf_counters(val); }
+void set_threads(int val) { test_params.set_threads((unsigned int)val); }
+void set_rank_aggregate(bool val) { test_params.set_rank_aggregate(val); }
+void set_adaptive(bool val) { test_params.set_adaptive(val); }
+std::string input_name("uniform");
+void set_input(std::string val) { input_name = val; }
+std::string vlen_sweep_spec("");
+void set_vlen_sweep(std::string val) { vlen_sweep_spec = val; }
+std::string memory_levels_spec("");
+void set_memory_levels(std::string val) { memory_levels_spec = val; }
+std::string rank_level("");
+void set_rank_level(std::string val) { rank_level = val; }
+bool denormal_penalty = false;
+void set_denormal_penalty(bool val) { denormal_penalty = val; }
+bool numa_bandwidth = false;
+void set_numa_bandwidth(bool val) { numa_bandwidth = val; }
 void set_substr(std::string val) { test_params.set_regex(val); }
 bool update_mode = false;
 void set_update(bool val) { update_mode = val; }
@@ -48,6 +75,15 @@ std::string json_filename("");
 void set_json(std::string val) { json_filename = val; }
 std::string volk_config_path("");
 void set_volk_config(std::string val) { volk_config_path = val; }
+std::string config_section("");
+bool host_section = false;
+void set_host_section(bool val) { host_section = val; }
+std::string machine_selection("");
+void set_machine(std::string val) { machine_selection = val; }
+std::string mixed_selections("");
+void set_mixed_workload(std::string val) { mixed_selections = val; }
+std::string mixed_child_selection("");
+void set_mixed_workload_child(std::string val) { mixed_child_selection = val; }
 
 int main(int argc, char* argv[])
 {
@@ -59,8 +95,65 @@ int main(int argc, char* argv[])
         option_t("tol", "t", "Set the default tolerance for all tests", set_tolerance));
     profile_options.add(
         option_t("vlen", "v", "Set the default vector length for tests", set_vlen));
+    profile_options.add((option_t("vlen-sweep",
+                                  "V",
+                                  "Profile every vector length of first:last:step, "
+                                  "e.g. 16:1M:x2, and write length buckets",
+                                  set_vlen_sweep)));
+    profile_options.add((option_t("memory-levels",
+                                  "L",
+                                  "Profile with data in these of l1,l2,llc,dram or all, "
+                                  "reporting GB/s and elements/cycle",
+                                  set_memory_levels)));
+    profile_options.add((option_t("rank-level",
+                                  "r",
+                                  "Memory level whose ranking is written, default the "
+                                  "last of --memory-levels",
+                                  set_rank_level)));
+    profile_options.add((option_t("denormal-penalty",
+                                  "D",
+                                  "Also time every implementation on denormal inputs, "
+                                  "with and without flushing them to zero",
+                                  set_denormal_penalty)));
+    profile_options.add((option_t("numa",
+                                  "N",
+                                  "Profile with data out of the caches on the local and "
+                                  "on a remote NUMA node, reporting GB/s of both",
+                                  set_numa_bandwidth)));
     profile_options.add((option_t(
         "iter", "i", "Set the default number of test iterations per kernel", set_iter)));
+    profile_options.add((option_t("warmup",
+                                  "w",
+                                  "Set the number of untimed calls before the timed ones",
+                                  set_warmup)));
+    profile_options.add(
+        (option_t("pin-cpu", "c", "Pin the timing thread to this CPU", set_pin_cpu)));
+    profile_options.add((option_t("perf-counters",
+                                  "P",
+                                  "Collect cycles, instructions, cache misses and clock "
+                                  "frequency with perf_event_open",
+                                  set_perf_counters)));
+    profile_options.add((option_t("threads",
+                                  "T",
+                                  "Also run every implementation on this many pinned "
+                                  "threads at once, each with its own buffers",
+                                  set_threads)));
+    profile_options.add((option_t("rank-aggregate",
+                                  "A",
+                                  "Rank implementations by their throughput on all "
+                                  "--threads together",
+                                  set_rank_aggregate)));
+    profile_options.add((option_t("fast",
+                                  "F",
+                                  "Time implementations only until their ranking is "
+                                  "settled, with --iter calls at most",
+                                  set_adaptive)));
+    profile_options.add((option_t("input",
+                                  "d",
+                                  "Fill the inputs with one of " +
+                                      volk_test_input_names() +
+                                      ", rankings may differ per distribution",
+                                  set_input)));
     profile_options.add(
         (option_t("tests-substr", "R", "Run tests matching substring", set_substr)));
     profile_options.add(
@@ -74,12 +167,100 @@ int main(int argc, char* argv[])
         "json", "j", "Write results to JSON file named as argument value", set_json)));
     profile_options.add(
         (option_t("path", "p", "Specify the volk_config path", set_volk_config)));
+    profile_options.add((option_t("host-section",
+                                  "s",
+                                  "Write results to this host's volk_config section, "
+                                  "keeping the sections of other hosts",
+                                  set_host_section)));
+    profile_options.add((option_t("machine",
+                                  "M",
+                                  "Profile this machine or policy, see volk_set_machine",
+                                  set_machine)));
+    profile_options.add((option_t("mixed-workload",
+                                  "m",
+                                  "Compare whole machine throughput of a mixed workload "
+                                  "per machine selection, e.g. max-caps,prefer-no-avx512",
+                                  set_mixed_workload)));
+    profile_options.add((option_t("mixed-workload-child",
+                                  "",
+                                  "Internal, one measurement of --mixed-workload",
+                                  set_mixed_workload_child)));
     profile_options.parse(argc, argv);
 
     if (profile_options.present("help")) {
         return 0;
     }
 
+    // the machine is fixed by the first VOLK call that needs it
+    if (mixed_child_selection != "") {
+        if (!volk_set_machine(mixed_child_selection.c_str())) {
+            return 2;
+        }
+        double rate = run_mixed_workload(std::thread::hardware_concurrency(), 2.0);
+        std::cout << volk_get_machine() << " " << rate << std::endl;
+        return 0;
+    }
+    if (machine_selection != "" && !volk_set_machine(machine_selection.c_str())) {
+        std::cerr << "No machine matches " << machine_selection << std::endl;
+        return 1;
+    }
+    if (mixed_selections != "") {
+        return compare_machine_selections(argv[0], mixed_selections);
+    }
+    volk_test_input_t input;
+    if (!volk_test_input_from_string(input_name, input)) {
+        std::cerr << "Invalid input distribution " << input_name << ", expected one of "
+                  << volk_test_input_names() << std::endl;
+        return 1;
+    }
+    test_params.set_input(input);
+    if (host_section) {
+        config_section = volk_get_cpu_fingerprint();
+    }
+    std::vector<unsigned int> sweep_lengths;
+    if (vlen_sweep_spec != "" && !parse_vlen_sweep(vlen_sweep_spec, sweep_lengths)) {
+        std::cerr << "Invalid vector length sweep " << vlen_sweep_spec
+                  << ", expected first:last:xFACTOR or first:last:+STEP" << std::endl;
+        return 1;
+    }
+    std::vector<std::string> memory_levels;
+    if (memory_levels_spec != "") {
+        if (!parse_memory_levels(memory_levels_spec, memory_levels)) {
+            std::cerr << "Invalid memory levels " << memory_levels_spec
+                      << ", expected a list of l1,l2,llc,dram or all" << std::endl;
+            return 1;
+        }
+        if (rank_level == "") {
+            rank_level = memory_levels.back();
+        }
+        if (std::find(memory_levels.begin(), memory_levels.end(), rank_level) ==
+            memory_levels.end()) {
+            std::cerr << "The rank level must be one of --memory-levels" << std::endl;
+            return 1;
+        }
+        if (!sweep_lengths.empty()) {
+            std::cerr << "--memory-levels and --vlen-sweep are exclusive" << std::endl;
+            return 1;
+        }
+    }
+    if (denormal_penalty && (!sweep_lengths.empty() || !memory_levels.empty())) {
+        std::cerr << "--denormal-penalty excludes --vlen-sweep and --memory-levels"
+                  << std::endl;
+        return 1;
+    }
+    if (numa_bandwidth) {
+        if (denormal_penalty || !sweep_lengths.empty() || !memory_levels.empty()) {
+            std::cerr << "--numa excludes --vlen-sweep, --memory-levels and "
+                         "--denormal-penalty"
+                      << std::endl;
+            return 1;
+        }
+        if (volk_get_numa_nodes() < 2) {
+            std::cerr << "--numa needs a host with more than one NUMA node" << std::endl;
+            return 1;
+        }
+    }
+
     if (dry_run) {
         std::cout << "Warning: this IS a dry-run. Config will not be written!"
                   << std::endl;
@@ -105,6 +286,7 @@ int main(int argc, char* argv[])
         else
             read_results(&results);
     }
+    const size_t n_prior_results = results.size();
 
     // Initialize the list of tests
     std::vector<volk_test_case_t> test_cases = init_test_list(test_params);
@@ -136,12 +318,26 @@ int main(int argc, char* argv[])
 
         if (regex_match && update) {
             try {
-                run_volk_tests(test_case.desc(),
-                               test_case.kernel_ptr(),
-                               test_case.name(),
-                               test_case.test_parameters(),
-                               &results,
-                               test_case.puppet_master_name());
+                if (!sweep_lengths.empty()) {
+                    run_vlen_sweep(test_case, sweep_lengths, &results);
+                } else if (memory_levels.empty() && !denormal_penalty &&
+                           !numa_bandwidth && has_streaming_impls(test_case.desc())) {
+                    // find the length from which the streaming stores win
+                    run_vlen_sweep(test_case, cache_sweep_lengths(), &results);
+                } else if (!memory_levels.empty()) {
+                    run_memory_levels(test_case, memory_levels, rank_level, &results);
+                } else if (denormal_penalty) {
+                    run_denormal_penalty(test_case, &results);
+                } else if (numa_bandwidth) {
+                    run_numa_bandwidth(test_case, &results);
+                } else {
+                    run_volk_tests(test_case.desc(),
+                                   test_case.kernel_ptr(),
+                                   test_case.name(),
+                                   test_case.test_parameters(),
+                                   &results,
+                                   test_case.puppet_master_name());
+                }
             } catch (std::string& error) {
                 std::cerr << "Caught Exception in 'run_volk_tests': " << error
                           << std::endl;
@@ -157,10 +353,13 @@ int main(int argc, char* argv[])
     }
 
     if (!dry_run) {
+        // in update mode the new results are merged into the existing config
+        const std::vector<volk_test_results_t> new_results(
+            results.begin() + n_prior_results, results.end());
         if (config_file != "")
-            write_results(&results, false, config_file);
+            write_results(&new_results, update_mode, config_file, config_section);
         else
-            write_results(&results, false);
+            write_results(&new_results, update_mode, config_section);
     } else {
         std::cout << "Warning: this was a dry-run. Config not generated" << std::endl;
     }
@@ -187,47 +386,57 @@ void read_results(std::vector<volk_test_results_t>* results, std::string path)
     if (config_status) {
         // a config exists and we are reading results from it
         std::ifstream config(path.c_str());
-        char config_line[256];
-        while (config.getline(config_line, 255)) {
+        std::string config_str;
+        // skip the sections written for other hosts, and the global lines
+        // too when only our own section gets rewritten
+        bool skip = config_section != "";
+        while (std::getline(config, config_str)) {
+            char section[256];
+            if (volk_parse_section(config_str.c_str(), section, sizeof(section))) {
+                skip = std::string(section) != volk_get_cpu_fingerprint();
+                continue;
+            }
+            if (skip) {
+                continue;
+            }
+
             // tokenize the input line by kernel_name unaligned aligned
             // then push back in the results vector with fields filled in
 
             std::vector<std::string> single_kernel_result;
-            std::string config_str(config_line);
-            std::size_t str_size = config_str.size();
-            std::size_t found = config_str.find(' ');
-
-            // Split line by spaces
-            while (found && found < str_size) {
-                found = config_str.find(' ');
-                // kernel names MUST be less than 128 chars, which is
-                // a length restricted by volk/volk_prefs.c
-                // on the last token in the parsed string we won't find a space
-                // so make sure we copy at most 128 chars.
-                if (found > 127) {
-                    found = 127;
-                }
-                str_size = config_str.size();
-                char line_buffer[128] = { '\0' };
-                config_str.copy(line_buffer, found + 1, 0);
-                line_buffer[found] = '\0';
-                single_kernel_result.push_back(std::string(line_buffer));
-                config_str.erase(0, found + 1);
+            std::istringstream tokens(config_str);
+            std::string token;
+            while (tokens >> token) {
+                single_kernel_result.push_back(token);
             }
 
-            if (single_kernel_result.size() == 3) {
+            // name, best_arch_a, best_arch_u, then optional length buckets
+            // as min_points, best_arch_a, best_arch_u triples
+            if (single_kernel_result.size() >= 3 &&
+                single_kernel_result.size() % 3 == 0 &&
+                single_kernel_result[0].compare(0, 5, "volk_") == 0) {
                 volk_test_results_t kernel_result;
                 kernel_result.name = std::string(single_kernel_result[0]);
                 kernel_result.config_name = std::string(single_kernel_result[0]);
-                kernel_result.best_arch_u = std::string(single_kernel_result[1]);
-                kernel_result.best_arch_a = std::string(single_kernel_result[2]);
+                kernel_result.best_arch_a = std::string(single_kernel_result[1]);
+                kernel_result.best_arch_u = std::string(single_kernel_result[2]);
+                for (size_t ii = 3; ii < single_kernel_result.size(); ii += 3) {
+                    volk_test_length_bucket_t bucket;
+                    bucket.min_points =
+                        std::strtoul(single_kernel_result[ii].c_str(), NULL, 10);
+                    bucket.best_arch_a = single_kernel_result[ii + 1];
+                    bucket.best_arch_u = single_kernel_result[ii + 2];
+                    kernel_result.length_buckets.push_back(bucket);
+                }
                 results->push_back(kernel_result);
             }
         }
     }
 }
 
-void write_results(const std::vector<volk_test_results_t>* results, bool update_result)
+void write_results(const std::vector<volk_test_results_t>* results,
+                   bool update_result,
+                   const std::string section)
 {
     char path[1024];
     volk_get_config_path(path, false);
@@ -236,12 +445,13 @@ void write_results(const std::vector<volk_test_results_t>* results, bool update_
         return;
     }
 
-    write_results(results, update_result, std::string(path));
+    write_results(results, update_result, std::string(path), section);
 }
 
 void write_results(const std::vector<volk_test_results_t>* results,
                    bool update_result,
-                   const std::string path)
+                   const std::string path,
+                   const std::string section)
 {
     //    struct stat buffer;
     //    bool config_status = (stat (path.c_str(), &buffer) == 0);
@@ -255,37 +465,153 @@ void write_results(const std::vector<volk_test_results_t>* results,
         fs::create_directories(config_path.parent_path());
     }
 
-    std::ofstream config;
-    if (update_result) {
-        std::cout << "Updating " << path << "..." << std::endl;
-        config.open(path.c_str(), std::ofstream::app);
-        if (!config.is_open()) { // either we don't have write access or we don't have the
-                                 // dir yet
-            std::cout << "Error opening file " << path << std::endl;
-        }
-    } else {
-        std::cout << "Writing " << path << "..." << std::endl;
-        config.open(path.c_str());
-        if (!config.is_open()) { // either we don't have write access or we don't have the
-                                 // dir yet
-            std::cout << "Error opening file " << path << std::endl;
+    // Keep every line outside the section being written. In update mode
+    // the section keeps its entries too, except those of kernels in results.
+    // A section "" is the global part in front of the first [section].
+    std::vector<std::string> kept_lines;
+    std::vector<std::string> section_lines;
+    if (section != "" || update_result) {
+        std::ifstream old_config(path.c_str());
+        std::string line;
+        bool in_section = section == "";
+        char line_section[256];
+        while (std::getline(old_config, line)) {
+            if (volk_parse_section(line.c_str(), line_section, sizeof(line_section))) {
+                in_section = std::string(line_section) == section;
+                if (!in_section) {
+                    kept_lines.push_back(line);
+                }
+                continue; // our header is written again below
+            }
+            if (!in_section) {
+                kept_lines.push_back(line);
+                continue;
+            }
+            if (!update_result) {
+                continue;
+            }
+            std::string kernel_name;
+            std::istringstream(line) >> kernel_name;
+            bool rewritten = false;
+            for (const auto& result : *results) {
+                rewritten = rewritten || result.config_name == kernel_name;
+            }
+            if (!rewritten) {
+                section_lines.push_back(line);
+            }
         }
+    }
 
+    std::ofstream config;
+    std::cout << (update_result ? "Updating " : "Writing ") << path << "..." << std::endl;
+    config.open(path.c_str());
+    if (!config.is_open()) { // either we don't have write access or we don't have the
+                             // dir yet
+        std::cout << "Error opening file " << path << std::endl;
+    }
+
+    if (kept_lines.empty() && section_lines.empty()) {
         config << "\
 #this file is generated by volk_profile.\n\
 #the function name is followed by the preferred architecture.\n\
+#optional triples of min_points impl_a impl_u override it for longer vectors.\n\
+#[fingerprint] lines start sections which only apply to that host.\n\
 ";
     }
+    if (section != "") {
+        for (const auto& line : kept_lines) {
+            config << line << std::endl;
+        }
+        config << "[" << section << "]" << std::endl;
+    }
+    for (const auto& line : section_lines) {
+        config << line << std::endl;
+    }
 
     std::vector<volk_test_results_t>::const_iterator profile_results;
     for (profile_results = results->begin(); profile_results != results->end();
          ++profile_results) {
         config << profile_results->config_name << " " << profile_results->best_arch_a
-               << " " << profile_results->best_arch_u << std::endl;
+               << " " << profile_results->best_arch_u;
+        for (const auto& bucket : profile_results->length_buckets) {
+            config << " " << bucket.min_points << " " << bucket.best_arch_a << " "
+                   << bucket.best_arch_u;
+        }
+        config << std::endl;
+    }
+    // the global part comes first, other sections follow it
+    if (section == "") {
+        for (const auto& line : kept_lines) {
+            config << line << std::endl;
+        }
     }
     config.close();
 }
 
+static void write_json_arch_values(std::ofstream& json_file,
+                                   const std::string& key,
+                                   const std::map<std::string, double>& values)
+{
+    json_file << "     \"" << key << "\": {";
+    size_t vi = 0;
+    for (const auto& arch : values) {
+        json_file << (vi++ ? ", " : "") << "\"" << arch.first << "\": " << arch.second;
+    }
+    json_file << "}";
+}
+
+static void write_json_sweep(std::ofstream& json_file, const volk_test_results_t& result)
+{
+    json_file << "   \"length_buckets\": [" << std::endl;
+    for (size_t bi = 0; bi < result.length_buckets.size(); bi++) {
+        const volk_test_length_bucket_t& bucket = result.length_buckets[bi];
+        json_file << "    {\"min_points\": " << bucket.min_points
+                  << ", \"best_arch_a\": \"" << bucket.best_arch_a
+                  << "\", \"best_arch_u\": \"" << bucket.best_arch_u << "\"}";
+        json_file << (bi + 1 != result.length_buckets.size() ? "," : "") << std::endl;
+    }
+    json_file << "   ]," << std::endl;
+    json_file << "   \"sweep\": [" << std::endl;
+    for (size_t pi = 0; pi < result.sweep.size(); pi++) {
+        const volk_test_sweep_point_t& point = result.sweep[pi];
+        json_file << "    {" << std::endl;
+        json_file << "     \"vlen\": " << point.vlen << "," << std::endl;
+        json_file << "     \"iter\": " << point.iter << "," << std::endl;
+        json_file << "     \"best_arch_a\": \"" << point.best_arch_a << "\","
+                  << std::endl;
+        json_file << "     \"best_arch_u\": \"" << point.best_arch_u << "\","
+                  << std::endl;
+        write_json_arch_values(json_file, "elements_per_ns", point.throughput);
+        json_file << std::endl;
+        json_file << "    }" << (pi + 1 != result.sweep.size() ? "," : "") << std::endl;
+    }
+    json_file << "   ]";
+}
+
+static void write_json_memory_levels(std::ofstream& json_file,
+                                     const volk_test_results_t& result)
+{
+    json_file << "   \"memory_levels\": [" << std::endl;
+    for (size_t li = 0; li < result.memory_levels.size(); li++) {
+        const volk_test_memory_level_t& level = result.memory_levels[li];
+        json_file << "    {" << std::endl;
+        json_file << "     \"level\": \"" << level.level << "\"," << std::endl;
+        json_file << "     \"vlen\": " << level.vlen << "," << std::endl;
+        json_file << "     \"buffer_sets\": " << level.buffer_sets << "," << std::endl;
+        json_file << "     \"best_arch_a\": \"" << level.best_arch_a << "\","
+                  << std::endl;
+        json_file << "     \"best_arch_u\": \"" << level.best_arch_u << "\","
+                  << std::endl;
+        write_json_arch_values(json_file, "gb_per_s", level.gb_per_s);
+        json_file << "," << std::endl;
+        write_json_arch_values(json_file, "elements_per_cycle", level.elements_per_cycle);
+        json_file << std::endl;
+        json_file << "    }" << (li + 1 != result.memory_levels.size() ? "," : "")
+                  << std::endl;
+    }
+    json_file << "   ]";
+}
+
 void write_json(std::ofstream& json_file, std::vector<volk_test_results_t> results)
 {
     json_file << "{" << std::endl;
@@ -298,10 +624,22 @@ void write_json(std::ofstream& json_file, std::vector<volk_test_results_t> resul
         json_file << "   \"name\": \"" << result->name << "\"," << std::endl;
         json_file << "   \"vlen\": " << (int)(result->vlen) << "," << std::endl;
         json_file << "   \"iter\": " << result->iter << "," << std::endl;
+        json_file << "   \"warmup\": " << result->warmup << "," << std::endl;
+        json_file << "   \"pin_cpu\": " << result->pin_cpu << "," << std::endl;
+        json_file << "   \"threads\": " << result->threads << "," << std::endl;
+        json_file << "   \"rank_aggregate\": "
+                  << (result->rank_aggregate ? "true" : "false") << "," << std::endl;
+        json_file << "   \"adaptive\": " << (result->adaptive ? "true" : "false") << ","
+                  << std::endl;
+        json_file << "   \"input\": \"" << result->input << "\"," << std::endl;
         json_file << "   \"best_arch_a\": \"" << result->best_arch_a << "\","
                   << std::endl;
         json_file << "   \"best_arch_u\": \"" << result->best_arch_u << "\","
                   << std::endl;
+        json_file << "   \"significant_a\": "
+                  << (result->significant_a ? "true" : "false") << "," << std::endl;
+        json_file << "   \"significant_u\": "
+                  << (result->significant_u ? "true" : "false") << "," << std::endl;
         json_file << "   \"results\": {" << std::endl;
         size_t results_len = result->results.size();
         size_t ri = 0;
@@ -314,6 +652,28 @@ void write_json(std::ofstream& json_file, std::vector<volk_test_results_t> resul
             json_file << "    \"" << time.name << "\": {" << std::endl;
             json_file << "     \"name\": \"" << time.name << "\"," << std::endl;
             json_file << "     \"time\": " << time.time << "," << std::endl;
+            json_file << "     \"samples\": " << time.samples << "," << std::endl;
+            json_file << "     \"median\": " << time.median << "," << std::endl;
+            json_file << "     \"p90\": " << time.p90 << "," << std::endl;
+            json_file << "     \"p99\": " << time.p99 << "," << std::endl;
+            json_file << "     \"cv\": " << time.cv << "," << std::endl;
+            if (!time.thread_throughput.empty()) {
+                json_file << "     \"aggregate_throughput\": "
+                          << time.aggregate_throughput << "," << std::endl;
+                json_file << "     \"thread_throughput\": [";
+                for (size_t ti = 0; ti < time.thread_throughput.size(); ti++) {
+                    json_file << (ti ? ", " : "") << time.thread_throughput[ti];
+                }
+                json_file << "]," << std::endl;
+            }
+            if (time.has_counters) {
+                json_file << "     \"counters\": {\"cycles\": " << time.cycles
+                          << ", \"instructions\": " << time.instructions
+                          << ", \"ipc\": " << time.ipc
+                          << ", \"l1d_misses\": " << time.l1d_misses
+                          << ", \"llc_misses\": " << time.llc_misses
+                          << ", \"ghz\": " << time.ghz << "}," << std::endl;
+            }
             json_file << "     \"units\": \"" << time.units << "\"" << std::endl;
             json_file << "    }";
             if (ri + 1 != results_len) {
@@ -322,7 +682,35 @@ void write_json(std::ofstream& json_file, std::vector<volk_test_results_t> resul
             json_file << std::endl;
             ri++;
         }
-        json_file << "   }" << std::endl;
+        json_file << "   }";
+        if (!result->sweep.empty()) {
+            json_file << "," << std::endl;
+            write_json_sweep(json_file, *result);
+        }
+        if (!result->memory_levels.empty()) {
+            json_file << "," << std::endl;
+            write_json_memory_levels(json_file, *result);
+        }
+        if (!result->denormal_penalty.empty()) {
+            json_file << "," << std::endl;
+            write_json_arch_values(
+                json_file, "denormal_penalty", result->denormal_penalty);
+            if (!result->flushed_penalty.empty()) {
+                json_file << "," << std::endl;
+                write_json_arch_values(
+                    json_file, "flushed_penalty", result->flushed_penalty);
+            }
+        }
+        if (!result->local_gb_per_s.empty()) {
+            json_file << "," << std::endl;
+            json_file << "   \"local_node\": " << result->local_node << "," << std::endl;
+            json_file << "   \"remote_node\": " << result->remote_node << ","
+                      << std::endl;
+            write_json_arch_values(json_file, "local_gb_per_s", result->local_gb_per_s);
+            json_file << "," << std::endl;
+            write_json_arch_values(json_file, "remote_gb_per_s", result->remote_gb_per_s);
+        }
+        json_file << std::endl;
         json_file << "  }";
         if (i + 1 != len) {
             json_file << ",";
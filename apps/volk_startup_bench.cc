@@ -0,0 +1,174 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of VOLK
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+/*
+ * Measures what a fresh process pays before its first VOLK kernel call
+ * returns. Every run forks a child which dlopen()s libvolk, then lets a
+ * number of threads hit the same kernel dispatcher at once. Compare a
+ * default build against one configured with -DENABLE_EAGER_DISPATCH=ON.
+ */
+
+#include <dlfcn.h>              // for dlopen, dlsym, dlerror
+#include <sys/wait.h>           // for waitpid
+#include <unistd.h>             // for fork, pipe, read, write
+#include <volk/volk_typedefs.h> // for p_32f_x2_add_32f
+#include <algorithm>            // for sort, max
+#include <atomic>               // for atomic
+#include <chrono>               // for steady_clock
+#include <iomanip>              // for setw, setprecision
+#include <iostream>             // for cout, cerr
+#include <string>               // for string
+#include <thread>               // for thread
+#include <vector>               // for vector
+
+#include "volk_option_helpers.h" // for option_list, option_t
+
+namespace {
+
+typedef std::chrono::steady_clock bench_clock;
+
+int n_runs = 20;
+int n_threads = 4;
+unsigned int vlen = 64;
+std::string library_path(VOLK_LIBRARY_PATH);
+
+void set_runs(int val) { n_runs = std::max(val, 1); }
+void set_threads(int val) { n_threads = std::max(val, 1); }
+void set_vlen(int val) { vlen = (unsigned int)std::max(val, 1); }
+void set_library(std::string val) { library_path = val; }
+
+struct startup_sample {
+    double load_us;       // dlopen, includes library constructors
+    double first_call_us; // slowest first call among the racing threads
+    double next_call_us;  // one more call on a warm dispatcher, for reference
+};
+
+double elapsed_us(bench_clock::time_point start, bench_clock::time_point stop)
+{
+    return std::chrono::duration<double, std::micro>(stop - start).count();
+}
+
+int run_child(int fd)
+{
+    startup_sample sample;
+
+    auto t0 = bench_clock::now();
+    void* handle = dlopen(library_path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    auto t1 = bench_clock::now();
+    if (!handle) {
+        std::cerr << "dlopen failed: " << dlerror() << std::endl;
+        return 1;
+    }
+    sample.load_us = elapsed_us(t0, t1);
+
+    auto kernel = (p_32f_x2_add_32f*)dlsym(handle, "volk_32f_x2_add_32f");
+    if (!kernel) {
+        std::cerr << "dlsym failed: " << dlerror() << std::endl;
+        return 1;
+    }
+
+    std::vector<std::vector<float>> buffers(3 * n_threads, std::vector<float>(vlen, 1.f));
+    std::vector<double> first_call(n_threads);
+    std::atomic<bool> go(false);
+    std::vector<std::thread> workers;
+    for (int ii = 0; ii < n_threads; ++ii) {
+        workers.emplace_back([&, ii]() {
+            float* out = buffers[3 * ii].data();
+            const float* in0 = buffers[3 * ii + 1].data();
+            const float* in1 = buffers[3 * ii + 2].data();
+            while (!go.load(std::memory_order_acquire)) {
+            }
+            auto start = bench_clock::now();
+            (*kernel)(out, in0, in1, vlen);
+            first_call[ii] = elapsed_us(start, bench_clock::now());
+        });
+    }
+
+    go.store(true, std::memory_order_release);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    sample.first_call_us = *std::max_element(first_call.begin(), first_call.end());
+
+    auto t2 = bench_clock::now();
+    (*kernel)(buffers[0].data(), buffers[1].data(), buffers[2].data(), vlen);
+    sample.next_call_us = elapsed_us(t2, bench_clock::now());
+
+    ssize_t written = write(fd, &sample, sizeof(sample));
+    return written == (ssize_t)sizeof(sample) ? 0 : 1;
+}
+
+double median(std::vector<double> vals)
+{
+    std::sort(vals.begin(), vals.end());
+    return vals[vals.size() / 2];
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    option_list bench_options("volk_startup_bench");
+    bench_options.add(
+        option_t("runs", "r", "Number of fresh processes to time", set_runs));
+    bench_options.add(
+        option_t("threads", "t", "Threads racing for the first call", set_threads));
+    bench_options.add(
+        option_t("vlen", "v", "Vector length of the kernel call", set_vlen));
+    bench_options.add(
+        option_t("library", "l", "Path of the libvolk to load", set_library));
+    bench_options.parse(argc, argv);
+
+    if (bench_options.present("help")) {
+        return 0;
+    }
+
+    std::vector<double> load, first_call, next_call, total;
+    for (int run = 0; run < n_runs; ++run) {
+        int fds[2];
+        if (pipe(fds) != 0) {
+            std::cerr << "pipe failed" << std::endl;
+            return 1;
+        }
+        pid_t pid = fork();
+        if (pid == 0) {
+            close(fds[0]);
+            _exit(run_child(fds[1]));
+        }
+        close(fds[1]);
+        startup_sample sample;
+        ssize_t got = read(fds[0], &sample, sizeof(sample));
+        close(fds[0]);
+        int status = 0;
+        waitpid(pid, &status, 0);
+        if (got != (ssize_t)sizeof(sample) || !WIFEXITED(status) ||
+            WEXITSTATUS(status) != 0) {
+            std::cerr << "run " << run << " failed" << std::endl;
+            return 1;
+        }
+        load.push_back(sample.load_us);
+        first_call.push_back(sample.first_call_us);
+        next_call.push_back(sample.next_call_us);
+        total.push_back(sample.load_us + sample.first_call_us);
+    }
+
+    std::cout << "library: " << library_path << std::endl;
+    std::cout << "runs: " << n_runs << ", threads: " << n_threads << ", vlen: " << vlen
+              << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "median dlopen:             " << std::setw(10) << median(load) << " us"
+              << std::endl;
+    std::cout << "median first call:         " << std::setw(10) << median(first_call)
+              << " us" << std::endl;
+    std::cout << "median load to first call: " << std::setw(10) << median(total)
+              << " us" << std::endl;
+    std::cout << "median warm call:          " << std::setw(10) << median(next_call)
+              << " us" << std::endl;
+    return 0;
+}
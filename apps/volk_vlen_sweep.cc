@@ -0,0 +1,211 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of VOLK
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include <volk/volk.h>       // for volk_get_cache_sizes
+#include <volk/volk_prefs.h> // for VOLK_MAX_LEN_BUCKETS
+#include <algorithm>         // for max, min
+#include <cstdlib>           // for strtoull
+#include <cstring>           // for strcmp, strlen
+#include <iomanip>           // for setw, setprecision
+#include <iostream>          // for cout, cerr
+#include <limits>            // for numeric_limits
+#include <map>               // for map
+
+#include "volk_vlen_sweep.h"
+
+namespace {
+
+bool parse_length(const std::string& text, unsigned long long& length)
+{
+    char* end = nullptr;
+    length = std::strtoull(text.c_str(), &end, 10);
+    if (end == text.c_str()) {
+        return false;
+    }
+    const std::string suffix(end);
+    if (suffix == "k" || suffix == "K") {
+        length <<= 10;
+    } else if (suffix == "m" || suffix == "M") {
+        length <<= 20;
+    } else if (!suffix.empty()) {
+        return false;
+    }
+    return length > 0 && length <= std::numeric_limits<unsigned int>::max();
+}
+
+} // namespace
+
+bool parse_vlen_sweep(const std::string& spec, std::vector<unsigned int>& lengths)
+{
+    lengths.clear();
+    const size_t first_colon = spec.find(':');
+    if (first_colon == std::string::npos) {
+        return false;
+    }
+    const size_t second_colon = spec.find(':', first_colon + 1);
+    if (second_colon == std::string::npos) {
+        return false;
+    }
+
+    unsigned long long first, last, step;
+    const std::string step_text = spec.substr(second_colon + 1);
+    if (!parse_length(spec.substr(0, first_colon), first) ||
+        !parse_length(spec.substr(first_colon + 1, second_colon - first_colon - 1),
+                      last) ||
+        step_text.size() < 2 || (step_text[0] != 'x' && step_text[0] != '+') ||
+        !parse_length(step_text.substr(1), step) || first > last) {
+        return false;
+    }
+    const bool multiply = step_text[0] == 'x';
+    if (multiply && step < 2) {
+        return false;
+    }
+
+    for (unsigned long long length = first; length <= last;
+         length = multiply ? length * step : length + step) {
+        lengths.push_back((unsigned int)length);
+    }
+    return true;
+}
+
+bool has_streaming_impls(const volk_func_desc_t& desc)
+{
+    for (size_t i = 0; i < desc.n_impls; i++) {
+        const size_t len = std::strlen(desc.impl_names[i]);
+        if (len > 3 && std::strcmp(desc.impl_names[i] + len - 3, "_nt") == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<unsigned int> cache_sweep_lengths()
+{
+    size_t l1, l2, llc;
+    volk_get_cache_sizes(&l1, &l2, &llc);
+    if (l2 == 0) {
+        l2 = 256 << 10;
+    }
+    if (llc == 0) {
+        llc = 8 << 20;
+    }
+    // the largest length is capped to keep the per arch buffers in memory
+    const size_t first = std::max<size_t>(l2 / 32, 1024);
+    const size_t last = std::min<size_t>(llc / 4, 1 << 24);
+    std::vector<unsigned int> lengths;
+    size_t length = 1;
+    while (length < first) {
+        length *= 2;
+    }
+    for (; length < 2 * last; length *= 2) {
+        lengths.push_back((unsigned int)length);
+    }
+    if (lengths.empty()) {
+        lengths.push_back((unsigned int)length);
+    }
+    return lengths;
+}
+
+void run_vlen_sweep(volk_test_case_t test_case,
+                    const std::vector<unsigned int>& lengths,
+                    std::vector<volk_test_results_t>* results)
+{
+    volk_test_params_t params = test_case.test_parameters();
+    const double points = (double)params.vlen() * params.iter();
+    const double max_iter = 16.0 * params.iter();
+
+    volk_test_results_t sweep_result;
+    for (unsigned int vlen : lengths) {
+        // run_volk_tests times vectors shorter than 1024 points in batches
+        const double sample_points = std::max(vlen, 1024u);
+        const double iter = std::max(std::min(points / sample_points, max_iter), 16.0);
+        params.set_vlen(vlen);
+        params.set_iter((unsigned int)iter);
+
+        std::vector<volk_test_results_t> point_results;
+        run_volk_tests(test_case.desc(),
+                       test_case.kernel_ptr(),
+                       test_case.name(),
+                       params,
+                       &point_results,
+                       test_case.puppet_master_name());
+        const volk_test_results_t& result = point_results.back();
+        if (result.results.empty()) {
+            return; // nothing to compare at any length
+        }
+
+        // the shortest length stands in for the whole sweep in the plain results
+        if (sweep_result.sweep.empty()) {
+            sweep_result = result;
+        }
+        volk_test_sweep_point_t point;
+        point.vlen = vlen;
+        point.iter = params.iter();
+        point.best_arch_a = result.best_arch_a;
+        point.best_arch_u = result.best_arch_u;
+        for (const auto& arch_time : result.results) {
+            if (arch_time.second.pass && arch_time.second.median > 0.0) {
+                point.throughput[arch_time.first] =
+                    vlen / (1e6 * arch_time.second.median);
+            }
+        }
+        sweep_result.sweep.push_back(point);
+    }
+    if (sweep_result.sweep.empty()) {
+        return;
+    }
+
+    // a length bucket starts at the first swept length where the best arch changes
+    const std::vector<volk_test_sweep_point_t>& sweep = sweep_result.sweep;
+    sweep_result.length_buckets.clear();
+    for (size_t ii = 1; ii < sweep.size(); ++ii) {
+        if (sweep[ii].best_arch_a == sweep[ii - 1].best_arch_a &&
+            sweep[ii].best_arch_u == sweep[ii - 1].best_arch_u) {
+            continue;
+        }
+        if (sweep_result.length_buckets.size() == VOLK_MAX_LEN_BUCKETS) {
+            std::cerr << "Warning: more than " << VOLK_MAX_LEN_BUCKETS
+                      << " crossovers, ignoring those from " << sweep[ii].vlen << " on"
+                      << std::endl;
+            break;
+        }
+        volk_test_length_bucket_t bucket;
+        bucket.min_points = sweep[ii].vlen;
+        bucket.best_arch_a = sweep[ii].best_arch_a;
+        bucket.best_arch_u = sweep[ii].best_arch_u;
+        sweep_result.length_buckets.push_back(bucket);
+    }
+
+    std::cout << "Elements/ns of " << test_case.name() << ":" << std::endl;
+    std::cout << std::setw(10) << "vlen";
+    for (const auto& arch : sweep.front().throughput) {
+        std::cout << std::setw(std::max<size_t>(12, arch.first.size() + 2)) << arch.first;
+    }
+    std::cout << std::endl << std::fixed << std::setprecision(3);
+    for (const auto& point : sweep) {
+        std::cout << std::setw(10) << point.vlen;
+        for (const auto& arch : sweep.front().throughput) {
+            const auto found = point.throughput.find(arch.first);
+            std::cout << std::setw(std::max<size_t>(12, arch.first.size() + 2))
+                      << (found == point.throughput.end() ? 0.0 : found->second);
+        }
+        std::cout << std::endl;
+    }
+    std::cout.unsetf(std::ios_base::floatfield);
+    std::cout << std::setprecision(6);
+
+    std::cout << "Best from " << sweep.front().vlen << ": " << sweep_result.best_arch_a
+              << " aligned, " << sweep_result.best_arch_u << " unaligned" << std::endl;
+    for (const auto& bucket : sweep_result.length_buckets) {
+        std::cout << "Best from " << bucket.min_points << ": " << bucket.best_arch_a
+                  << " aligned, " << bucket.best_arch_u << " unaligned" << std::endl;
+    }
+
+    results->push_back(sweep_result);
+}
@@ -0,0 +1,49 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of VOLK
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef VOLK_VOLK_VLEN_SWEEP_H
+#define VOLK_VOLK_VLEN_SWEEP_H
+
+#include <string> // for string
+#include <vector> // for vector
+
+#include "qa_utils.h" // for volk_test_case_t, volk_test_results_t
+
+/*
+ * Parse a sweep of vector lengths given as first:last:step, where step is
+ * xF to multiply by F or +N to add N, e.g. "16:1M:x2". Lengths take an
+ * optional k or M suffix for powers of 1024. Returns false on bad input.
+ */
+bool parse_vlen_sweep(const std::string& spec, std::vector<unsigned int>& lengths);
+
+/*
+ * Does the kernel have implementations with non-temporal stores, named
+ * *_nt? They only pay off on buffers larger than the last level cache,
+ * so volk_profile sweeps these kernels across the caches by default.
+ */
+bool has_streaming_impls(const volk_func_desc_t& desc);
+
+/*
+ * Powers of two from a length that fits the L2 cache to one whose
+ * buffers of 8 byte points are twice the size of the last level cache.
+ */
+std::vector<unsigned int> cache_sweep_lengths();
+
+/*
+ * Profile a kernel at every length of the sweep in this process, print
+ * the elements/ns of each implementation and where the best one changes,
+ * and append one result with the sweep and its length buckets. The
+ * iterations per length are scaled so every length processes about as
+ * many points as the kernel's default vlen and iter would.
+ */
+void run_vlen_sweep(volk_test_case_t test_case,
+                    const std::vector<unsigned int>& lengths,
+                    std::vector<volk_test_results_t>* results);
+
+#endif // VOLK_VOLK_VLEN_SWEEP_H
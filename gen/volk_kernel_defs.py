@@ -127,6 +127,7 @@ class impl_class(object):
 
         assert self.name
         self.is_aligned = self.name.startswith('a_')
+        self.is_padded = self.name.endswith('_padded')
 
     def __repr__(self):
         return self.name
@@ -168,10 +169,28 @@ class kernel_class(object):
                 self._impls.remove(impl)
                 self.has_dispatcher = True
                 break
+        #full vector variants for padded buffers, see get_padded_impls
+        self._padded_impls = [impl for impl in self._impls if impl.is_padded]
+        self._impls = [impl for impl in self._impls if not impl.is_padded]
+        for impl in self._padded_impls:
+            twins = [i for i in self._impls if i.name + '_padded' == impl.name]
+            assert twins, '%s_%s has no regular twin' % (self.name, impl.name)
+        self.has_padded = bool(self._padded_impls)
         self.args = self._impls[0].args
         self.arglist_types = ', '.join([a[0] for a in self.args])
         self.arglist_full = ', '.join(['%s %s'%a for a in self.args])
         self.arglist_names = ', '.join([a[1] for a in self.args])
+        #the vector length argument, used for length aware dispatch
+        arg_names = [a[1] for a in self.args]
+        self.len_arg = 'num_points' if 'num_points' in arg_names else None
+        #peel to alignment in the dispatcher, see splittable_kernels
+        self.splittable = (self.name in splittable_kernels and
+                           self.len_arg is not None and not self.has_dispatcher)
+        self.deprecated = self.name in deprecated_kernels
+        #volk_bench fills every pointer argument with a vector of num_points
+        #elements and every other argument with a scalar
+        self.benchmarkable = (self.len_arg is not None and not self.deprecated and
+                              all('**' not in a[0] for a in self.args))
 
     def get_impls(self, archs):
         archs = set(archs)
@@ -181,9 +200,133 @@ class kernel_class(object):
                 impls.append(impl)
         return impls
 
+    def get_padded_impls(self, archs):
+        """The padded twin of each impl in get_impls(archs), or None.
+
+        A padded twin, e.g. a_avx_padded next to a_avx, may read and write
+        up to VOLK_PADDING bytes past the end of each buffer. It is only
+        called through the _padded dispatcher, never ranked on its own.
+        """
+        archs = set(archs)
+        twins = dict((impl.name, impl) for impl in self._padded_impls
+                     if impl.deps.intersection(archs) == impl.deps)
+        return [twins.get(impl.name + '_padded') for impl in self.get_impls(archs)]
+
     def __repr__(self):
         return self.name
 
+########################################################################
+# Kernels that may be split into an unaligned head and an aligned bulk.
+# Every pointer argument of these kernels is an array of num_points
+# elements, and element i of the outputs only depends on element i of
+# the inputs. Reductions and kernels that carry state between elements
+# must not be listed here.
+########################################################################
+splittable_kernels = frozenset([
+    'volk_16i_convert_8i',
+    'volk_16i_s32f_convert_32f',
+    'volk_16ic_convert_32fc',
+    'volk_16ic_deinterleave_16i_x2',
+    'volk_16ic_deinterleave_real_16i',
+    'volk_16ic_deinterleave_real_8i',
+    'volk_16ic_magnitude_16i',
+    'volk_16ic_s32f_deinterleave_32f_x2',
+    'volk_16ic_s32f_deinterleave_real_32f',
+    'volk_16ic_s32f_magnitude_32f',
+    'volk_16ic_x2_multiply_16ic',
+    'volk_16u_byteswap',
+    'volk_32f_64f_add_64f',
+    'volk_32f_64f_multiply_64f',
+    'volk_32f_acos_32f',
+    'volk_32f_asin_32f',
+    'volk_32f_atan_32f',
+    'volk_32f_binary_slicer_32i',
+    'volk_32f_binary_slicer_8i',
+    'volk_32f_convert_64f',
+    'volk_32f_cos_32f',
+    'volk_32f_exp_32f',
+    'volk_32f_expfast_32f',
+    'volk_32f_invsqrt_32f',
+    'volk_32f_log2_32f',
+    'volk_32f_s32f_add_32f',
+    'volk_32f_s32f_convert_16i',
+    'volk_32f_s32f_convert_32i',
+    'volk_32f_s32f_convert_8i',
+    'volk_32f_s32f_multiply_32f',
+    'volk_32f_s32f_normalize',
+    'volk_32f_s32f_power_32f',
+    'volk_32f_s32f_s32f_mod_range_32f',
+    'volk_32f_s32f_x2_convert_8u',
+    'volk_32f_sin_32f',
+    'volk_32f_sqrt_32f',
+    'volk_32f_tan_32f',
+    'volk_32f_tanh_32f',
+    'volk_32f_x2_add_32f',
+    'volk_32f_x2_divide_32f',
+    'volk_32f_x2_interleave_32fc',
+    'volk_32f_x2_max_32f',
+    'volk_32f_x2_min_32f',
+    'volk_32f_x2_multiply_32f',
+    'volk_32f_x2_pow_32f',
+    'volk_32f_x2_s32f_interleave_16ic',
+    'volk_32f_x2_subtract_32f',
+    'volk_32fc_32f_add_32fc',
+    'volk_32fc_32f_multiply_32fc',
+    'volk_32fc_conjugate_32fc',
+    'volk_32fc_convert_16ic',
+    'volk_32fc_deinterleave_32f_x2',
+    'volk_32fc_deinterleave_64f_x2',
+    'volk_32fc_deinterleave_imag_32f',
+    'volk_32fc_deinterleave_real_32f',
+    'volk_32fc_deinterleave_real_64f',
+    'volk_32fc_magnitude_32f',
+    'volk_32fc_magnitude_squared_32f',
+    'volk_32fc_s32f_atan2_32f',
+    'volk_32fc_s32f_deinterleave_real_16i',
+    'volk_32fc_s32f_magnitude_16i',
+    'volk_32fc_s32f_power_32fc',
+    'volk_32fc_s32f_power_spectrum_32f',
+    'volk_32fc_s32f_x2_power_spectral_density_32f',
+    'volk_32fc_s32fc_multiply_32fc',
+    'volk_32fc_x2_add_32fc',
+    'volk_32fc_x2_divide_32fc',
+    'volk_32fc_x2_multiply_32fc',
+    'volk_32fc_x2_multiply_conjugate_32fc',
+    'volk_32fc_x2_s32fc_multiply_conjugate_add_32fc',
+    'volk_32i_s32f_convert_32f',
+    'volk_32i_x2_and_32i',
+    'volk_32i_x2_or_32i',
+    'volk_32u_byteswap',
+    'volk_32u_reverse_32u',
+    'volk_64f_convert_32f',
+    'volk_64f_x2_add_64f',
+    'volk_64f_x2_max_64f',
+    'volk_64f_x2_min_64f',
+    'volk_64f_x2_multiply_64f',
+    'volk_64u_byteswap',
+    'volk_8i_convert_16i',
+    'volk_8i_s32f_convert_32f',
+    'volk_8ic_deinterleave_16i_x2',
+    'volk_8ic_deinterleave_real_16i',
+    'volk_8ic_deinterleave_real_8i',
+    'volk_8ic_s32f_deinterleave_32f_x2',
+    'volk_8ic_s32f_deinterleave_real_32f',
+    'volk_8ic_x2_multiply_conjugate_16ic',
+    'volk_8ic_x2_s32f_multiply_conjugate_32fc',
+])
+
+########################################################################
+# Kernels whose public symbols are marked deprecated
+########################################################################
+deprecated_kernels = frozenset([
+    'volk_16i_x5_add_quad_16i_x4',
+    'volk_16i_branch_4_state_8',
+    'volk_16i_max_star_16i',
+    'volk_16i_max_star_horizontal_16i',
+    'volk_16i_permute_and_scalar_add',
+    'volk_16i_x4_quad_max_star_16i',
+])
+
 ########################################################################
 # Extract information from the VOLK kernels
 ########################################################################
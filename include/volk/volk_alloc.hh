@@ -10,12 +10,15 @@
 #ifndef INCLUDED_VOLK_ALLOC_H
 #define INCLUDED_VOLK_ALLOC_H
 
+#include <algorithm>
 #include <cstdlib>
 #include <limits>
 #include <new>
+#include <thread>
 #include <vector>
 
 #include <volk/volk.h>
+#include <volk/volk_pool.h>
 
 namespace volk {
 
@@ -73,5 +76,271 @@ bool operator!=(alloc<T> const&, alloc<U> const&)
 template <class T>
 using vector = std::vector<T, alloc<T>>;
 
+/*!
+ * \brief C++11 allocator using volk_pool_malloc and volk_pool_free
+ *
+ * \details
+ *   Recycles blocks through the calling thread's cache, see volk_pool_malloc.
+ */
+template <class T>
+struct pool_alloc {
+    typedef T value_type;
+
+    pool_alloc() = default;
+
+    template <class U>
+    constexpr pool_alloc(pool_alloc<U> const&) noexcept
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+            throw std::bad_alloc();
+
+        if (auto p =
+                static_cast<T*>(volk_pool_malloc(n * sizeof(T), volk_get_alignment())))
+            return p;
+
+        throw std::bad_alloc();
+    }
+
+    void deallocate(T* p, std::size_t) noexcept { volk_pool_free(p); }
+};
+
+template <class T, class U>
+bool operator==(pool_alloc<T> const&, pool_alloc<U> const&)
+{
+    return true;
+}
+
+template <class T, class U>
+bool operator!=(pool_alloc<T> const&, pool_alloc<U> const&)
+{
+    return false;
+}
+
+/*!
+ * \brief type alias for std::vector using volk::pool_alloc
+ *
+ * \details
+ * example code:
+ *   volk::pool_vector<float> scratch(n); // recycled when it goes out of scope
+ */
+template <class T>
+using pool_vector = std::vector<T, pool_alloc<T>>;
+
+/*!
+ * \brief C++11 allocator using volk_malloc_flags with VOLK_MALLOC_HUGE_PAGES
+ *
+ * \details
+ *   For buffers of many MB that kernels stream through, where TLB misses
+ *   show. Sizes are rounded up to whole huge pages, so prefer reserve()
+ *   over letting the vector grow. volk::alloc uses huge pages as well for
+ *   sizes above the threshold set with volk_set_huge_page_threshold.
+ */
+template <class T>
+struct huge_alloc {
+    typedef T value_type;
+
+    huge_alloc() = default;
+
+    template <class U>
+    constexpr huge_alloc(huge_alloc<U> const&) noexcept
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+            throw std::bad_alloc();
+
+        if (auto p = static_cast<T*>(volk_malloc_flags(
+                n * sizeof(T), volk_get_alignment(), VOLK_MALLOC_HUGE_PAGES)))
+            return p;
+
+        throw std::bad_alloc();
+    }
+
+    void deallocate(T* p, std::size_t) noexcept { volk_free(p); }
+};
+
+template <class T, class U>
+bool operator==(huge_alloc<T> const&, huge_alloc<U> const&)
+{
+    return true;
+}
+
+template <class T, class U>
+bool operator!=(huge_alloc<T> const&, huge_alloc<U> const&)
+{
+    return false;
+}
+
+/*!
+ * \brief type alias for std::vector using volk::huge_alloc
+ *
+ * \details
+ * example code:
+ *   volk::huge_vector<lv_32fc_t> spectrum(1 << 24); // backed by huge pages
+ */
+template <class T>
+using huge_vector = std::vector<T, huge_alloc<T>>;
+
+/*!
+ * \brief C++11 allocator using volk_malloc_flags with VOLK_MALLOC_PADDED
+ *
+ * \details
+ *   Every allocation is followed by VOLK_PADDING bytes of slack, so the
+ *   data() of a padded_vector may be passed to the _padded kernel
+ *   pointers. The slack sits behind the capacity, not the size, of the
+ *   vector; both are fine for the kernels.
+ */
+template <class T>
+struct padded_alloc {
+    typedef T value_type;
+
+    padded_alloc() = default;
+
+    template <class U>
+    constexpr padded_alloc(padded_alloc<U> const&) noexcept
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+        if (n > (std::numeric_limits<std::size_t>::max() - VOLK_PADDING) / sizeof(T))
+            throw std::bad_alloc();
+
+        if (auto p = static_cast<T*>(volk_malloc_flags(
+                n * sizeof(T), volk_get_alignment(), VOLK_MALLOC_PADDED)))
+            return p;
+
+        throw std::bad_alloc();
+    }
+
+    void deallocate(T* p, std::size_t) noexcept { volk_free(p); }
+};
+
+template <class T, class U>
+bool operator==(padded_alloc<T> const&, padded_alloc<U> const&)
+{
+    return true;
+}
+
+template <class T, class U>
+bool operator!=(padded_alloc<T> const&, padded_alloc<U> const&)
+{
+    return false;
+}
+
+/*!
+ * \brief type alias for std::vector using volk::padded_alloc
+ *
+ * \details
+ * example code:
+ *   volk::padded_vector<float> a(n), b(n), c(n);
+ *   volk_32f_x2_add_32f_padded(c.data(), a.data(), b.data(), n);
+ */
+template <class T>
+using padded_vector = std::vector<T, padded_alloc<T>>;
+
+/*!
+ * \brief C++11 allocator using volk_malloc_onnode and volk_free
+ *
+ * \details
+ *   Places the pages of every allocation on one NUMA node, so kernels
+ *   running there read local memory. Allocators of different nodes
+ *   compare unequal, so containers keep their node on assignment.
+ */
+template <class T>
+struct node_alloc {
+    typedef T value_type;
+
+    explicit node_alloc(int node = 0) noexcept : node(node) {}
+
+    template <class U>
+    constexpr node_alloc(node_alloc<U> const& other) noexcept : node(other.node)
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+            throw std::bad_alloc();
+
+        if (auto p = static_cast<T*>(
+                volk_malloc_onnode(n * sizeof(T), volk_get_alignment(), node)))
+            return p;
+
+        throw std::bad_alloc();
+    }
+
+    void deallocate(T* p, std::size_t) noexcept { volk_free(p); }
+
+    int node;
+};
+
+template <class T, class U>
+bool operator==(node_alloc<T> const& a, node_alloc<U> const& b)
+{
+    return a.node == b.node;
+}
+
+template <class T, class U>
+bool operator!=(node_alloc<T> const& a, node_alloc<U> const& b)
+{
+    return a.node != b.node;
+}
+
+/*!
+ * \brief type alias for std::vector using volk::node_alloc
+ *
+ * \details
+ * example code:
+ *   volk::node_vector<float> v(n, volk::node_alloc<float>(1)); // on node 1
+ */
+template <class T>
+using node_vector = std::vector<T, node_alloc<T>>;
+
+/*!
+ * \brief Value-initialize \p n elements at \p data from \p n_threads threads
+ *
+ * \details
+ *   Memory is placed on the node of the thread that touches a page first.
+ *   Thread k initializes the k-th contiguous chunk while preferring node
+ *   k * volk_get_numa_nodes() / n_threads, so when worker k later processes
+ *   chunk k from that node, its data is local. Pass memory nothing has
+ *   written yet, e.g. from volk_malloc; a std::vector has already touched
+ *   its elements on construction.
+ *
+ * example code:
+ *   float* buffer = (float*)volk_malloc(n * sizeof(float), volk_get_alignment());
+ *   volk::first_touch(buffer, n, 4); // a quarter per node of a 4 node host
+ */
+template <class T>
+void first_touch(T* data,
+                 std::size_t n,
+                 unsigned int n_threads = std::thread::hardware_concurrency())
+{
+    n_threads = std::max(1u, n_threads);
+    const int nodes = volk_get_numa_nodes();
+    const std::size_t chunk = (n + n_threads - 1) / n_threads;
+    std::vector<std::thread> workers;
+    for (unsigned int k = 0; k < n_threads && k * chunk < n; k++) {
+        workers.emplace_back([=]() {
+            volk_set_numa_memory_node((int)((std::size_t)k * nodes / n_threads));
+            T* end = data + std::min(n, (k + 1) * chunk);
+            for (T* p = data + k * chunk; p != end; ++p) {
+                ::new (static_cast<void*>(p)) T();
+            }
+            volk_set_numa_memory_node(-1);
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
 } // namespace volk
 #endif // INCLUDED_VOLK_ALLOC_H
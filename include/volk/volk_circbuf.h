@@ -0,0 +1,75 @@
+/* -*- c -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of VOLK
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_VOLK_CIRCBUF_H
+#define INCLUDED_VOLK_CIRCBUF_H
+
+#include <stdlib.h>
+#include <volk/volk_common.h>
+
+__VOLK_DECL_BEGIN
+
+/*!
+ * A ring buffer whose pages are mapped twice, back to back, so that the
+ * byte after the last one is the first one again. Every window of up to
+ * volk_circbuf_size bytes is contiguous in memory and can be passed to a
+ * kernel in one call, without splitting it at the wrap point.
+ *
+ * One thread may write while another one reads. Windows stay aligned to
+ * volk_get_alignment() as long as every produce and consume count is a
+ * multiple of it.
+ */
+typedef struct volk_circbuf volk_circbuf_t;
+
+/*!
+ * \brief Create a circular buffer of at least \p size bytes.
+ *
+ * \details
+ * The size is rounded up to a multiple of both the page size and
+ * \p item_size, so items never straddle the wrap point. The memory comes
+ * from memfd_create, or a shared memory object elsewhere, mapped twice.
+ *
+ * \param size The minimum number of bytes the buffer holds.
+ * \param item_size The size of one item, 1 for bytes.
+ * \return the buffer, NULL on failure or where double mapping is unsupported.
+ */
+VOLK_API volk_circbuf_t* volk_circbuf_create(size_t size, size_t item_size);
+
+//! Unmap the buffer and free it, NULL is ignored
+VOLK_API void volk_circbuf_destroy(volk_circbuf_t* buf);
+
+//! Capacity of the buffer in bytes
+VOLK_API size_t volk_circbuf_size(const volk_circbuf_t* buf);
+
+/*!
+ * \brief Where the next bytes go, with the free space in \p writable.
+ *
+ * \details
+ * All \p writable bytes from the returned pointer on may be written.
+ * They become readable with volk_circbuf_produce.
+ */
+VOLK_API void* volk_circbuf_write_ptr(volk_circbuf_t* buf, size_t* writable);
+
+//! Publish \p bytes written at volk_circbuf_write_ptr, at most the writable count
+VOLK_API void volk_circbuf_produce(volk_circbuf_t* buf, size_t bytes);
+
+/*!
+ * \brief The oldest unread bytes, with their count in \p readable.
+ *
+ * \details
+ * All \p readable bytes from the returned pointer on may be read.
+ */
+VOLK_API const void* volk_circbuf_read_ptr(volk_circbuf_t* buf, size_t* readable);
+
+//! Release \p bytes read at volk_circbuf_read_ptr, at most the readable count
+VOLK_API void volk_circbuf_consume(volk_circbuf_t* buf, size_t bytes);
+
+__VOLK_DECL_END
+
+#endif /* INCLUDED_VOLK_CIRCBUF_H */
@@ -0,0 +1,97 @@
+/* -*- C++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of VOLK
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_VOLK_CIRCBUF_HH
+#define INCLUDED_VOLK_CIRCBUF_HH
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <volk/volk_circbuf.h>
+
+namespace volk {
+
+/*!
+ * \brief Ring buffer of \p T whose every window is contiguous in memory
+ *
+ * \details
+ *   Wraps volk_circbuf: one thread may write while another one reads, and
+ *   a window of any length up to capacity() goes to a kernel in one call.
+ *
+ *       volk::circular_buffer<lv_32fc_t> ring(1 << 16);
+ *       std::size_t n = ring.writable();
+ *       produce_samples(ring.write_data(), n);
+ *       ring.produce(n);
+ *       ...
+ *       std::size_t n = ring.readable();
+ *       volk_32fc_x2_multiply_32fc(out, ring.read_data(), taps, n);
+ *       ring.consume(n);
+ */
+template <class T>
+class circular_buffer
+{
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "circular_buffer items are copied as bytes");
+
+public:
+    //! Holds at least \p min_items items, throws std::bad_alloc on failure
+    explicit circular_buffer(std::size_t min_items)
+        : _buf(volk_circbuf_create(min_items * sizeof(T), sizeof(T)))
+    {
+        if (!_buf)
+            throw std::bad_alloc();
+    }
+    ~circular_buffer() { volk_circbuf_destroy(_buf); }
+
+    circular_buffer(const circular_buffer&) = delete;
+    circular_buffer& operator=(const circular_buffer&) = delete;
+    circular_buffer(circular_buffer&& other) noexcept
+        : _buf(std::exchange(other._buf, nullptr))
+    {
+    }
+    circular_buffer& operator=(circular_buffer&& other) noexcept
+    {
+        std::swap(_buf, other._buf);
+        return *this;
+    }
+
+    std::size_t capacity() const { return volk_circbuf_size(_buf) / sizeof(T); }
+
+    //! Where the next items go, writable() of them
+    T* write_data() { return static_cast<T*>(volk_circbuf_write_ptr(_buf, nullptr)); }
+    std::size_t writable()
+    {
+        std::size_t bytes;
+        volk_circbuf_write_ptr(_buf, &bytes);
+        return bytes / sizeof(T);
+    }
+    void produce(std::size_t items) { volk_circbuf_produce(_buf, items * sizeof(T)); }
+
+    //! The oldest unread items, readable() of them
+    const T* read_data()
+    {
+        return static_cast<const T*>(volk_circbuf_read_ptr(_buf, nullptr));
+    }
+    std::size_t readable()
+    {
+        std::size_t bytes;
+        volk_circbuf_read_ptr(_buf, &bytes);
+        return bytes / sizeof(T);
+    }
+    void consume(std::size_t items) { volk_circbuf_consume(_buf, items * sizeof(T)); }
+
+private:
+    volk_circbuf_t* _buf;
+};
+
+} // namespace volk
+
+#endif // INCLUDED_VOLK_CIRCBUF_HH
@@ -0,0 +1,47 @@
+/* -*- C++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of VOLK
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_VOLK_DENORMALS_HH
+#define INCLUDED_VOLK_DENORMALS_HH
+
+#include <volk/volk.h>
+
+namespace volk {
+
+/*!
+ * \brief Flushes denormal floats to zero in the calling thread while in scope
+ *
+ * \details
+ *   Restores the previous denormal handling when it goes out of scope, e.g.
+ *
+ *       {
+ *           volk::flush_denormals ftz;
+ *           volk_32f_x2_multiply_32f(out, in0, in1, num_points);
+ *       }
+ *
+ *   See volk_flush_denormals.
+ */
+class flush_denormals
+{
+public:
+    explicit flush_denormals(bool enable = true) : _saved(volk_flush_denormals(enable))
+    {
+    }
+    ~flush_denormals() { volk_restore_denormals(_saved); }
+
+    flush_denormals(const flush_denormals&) = delete;
+    flush_denormals& operator=(const flush_denormals&) = delete;
+
+private:
+    volk_denormal_mode_t _saved;
+};
+
+} // namespace volk
+
+#endif // INCLUDED_VOLK_DENORMALS_HH
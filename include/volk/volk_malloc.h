@@ -41,6 +41,93 @@ __VOLK_DECL_BEGIN
  */
 VOLK_API void* volk_malloc(size_t size, size_t alignment);
 
+//! Back the allocation with huge pages where the platform has them
+#define VOLK_MALLOC_HUGE_PAGES 0x1u
+//! Never use huge pages, whatever the huge page threshold
+#define VOLK_MALLOC_NO_HUGE_PAGES 0x2u
+//! Follow the allocation with VOLK_PADDING bytes of slack, see below
+#define VOLK_MALLOC_PADDED 0x4u
+
+/*!
+ * Bytes of slack after a VOLK_MALLOC_PADDED allocation, the widest SIMD
+ * register VOLK uses. Kernels called through their _padded pointer, e.g.
+ * volk_32f_x2_add_32f_padded, may read and write up to this many bytes
+ * past the end of each buffer instead of finishing with a scalar tail.
+ * The slack is zeroed by the allocation; afterwards its contents are
+ * undefined.
+ */
+#define VOLK_PADDING 64
+
+/*!
+ * \brief Allocate like volk_malloc, with \p flags selecting the kind of memory.
+ *
+ * \details
+ * With VOLK_MALLOC_HUGE_PAGES, or when \p size is at least the huge page
+ * threshold, Linux builds first map explicit huge pages (MAP_HUGETLB),
+ * which requires pages reserved in /proc/sys/vm/nr_hugepages. Without a
+ * reservation the memory is aligned to the huge page size and advised as
+ * MADV_HUGEPAGE, so transparent huge pages back it where enabled. Sizes
+ * are rounded up to whole huge pages. Where huge pages are unavailable
+ * this behaves like volk_malloc. With VOLK_MALLOC_PADDED the \p size bytes
+ * are followed by VOLK_PADDING readable and writable bytes. Free the
+ * memory with volk_free.
+ *
+ * \param size The number of bytes to allocate.
+ * \param alignment The byte alignment of the allocated memory.
+ * \param flags VOLK_MALLOC_* flags or 0.
+ * \return pointer to aligned memory, NULL on failure.
+ */
+VOLK_API void* volk_malloc_flags(size_t size, size_t alignment, unsigned int flags);
+
+/*!
+ * \brief Serve volk_malloc calls of at least \p size bytes from huge pages.
+ *
+ * \details
+ * 0 turns the threshold off, leaving huge pages to VOLK_MALLOC_HUGE_PAGES.
+ * The initial threshold comes from the VOLK_HUGE_PAGES environment variable:
+ * 1, on, true or yes use the 2 MiB huge page size, 0, off, false or no turn
+ * it off, and a size needs a k, M or G suffix, e.g. VOLK_HUGE_PAGES=64M.
+ */
+VOLK_API void volk_set_huge_page_threshold(size_t size);
+
+//! The current huge page threshold in bytes, 0 if off
+VOLK_API size_t volk_get_huge_page_threshold(void);
+
+/*!
+ * \brief Allocate like volk_malloc, with the pages placed on NUMA node \p node.
+ *
+ * \details
+ * On Linux the memory is taken in whole pages and given a preferred node
+ * policy with the mbind system call, so it lands on \p node no matter which
+ * thread writes it first; a full node spills over to the others. Sizes are
+ * rounded up to whole pages and alignments up to the page size are
+ * supported. A negative \p node allocates like volk_malloc. The huge page
+ * threshold applies as for volk_malloc. Free with volk_free.
+ *
+ * \param size The number of bytes to allocate.
+ * \param alignment The byte alignment of the allocated memory.
+ * \param node The NUMA node, below volk_get_numa_nodes().
+ * \return pointer to aligned memory, NULL on failure or for unknown nodes.
+ */
+VOLK_API void* volk_malloc_onnode(size_t size, size_t alignment, int node);
+
+//! Number of NUMA nodes of this host, 1 where it has none or cannot tell
+VOLK_API int volk_get_numa_nodes(void);
+
+//! The NUMA node the calling thread runs on, and its CPU in \p cpu unless NULL
+VOLK_API int volk_get_numa_node(int* cpu);
+
+/*!
+ * \brief Prefer \p node for pages the calling thread touches first.
+ *
+ * \details
+ * Sets the memory policy of the calling thread only, with set_mempolicy.
+ * A negative \p node restores the default policy of the local node.
+ *
+ * \return 0 on success, -1 where the policy cannot be set.
+ */
+VOLK_API int volk_set_numa_memory_node(int node);
+
 /*!
  * \brief Free's memory allocated by volk_malloc.
  *
@@ -53,6 +140,8 @@ VOLK_API void* volk_malloc(size_t size, size_t alignment);
  * see:
  * https://docs.microsoft.com/en-us/cpp/c-runtime-library/reference/aligned-free?view=vs-2019
  *
+ * Huge page mappings made by volk_malloc_flags are unmapped instead.
+ *
  * \param aptr The aligned pointer allocated by volk_malloc.
  */
 VOLK_API void volk_free(void* aptr);
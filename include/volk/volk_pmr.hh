@@ -0,0 +1,208 @@
+/* -*- C++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of VOLK
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_VOLK_PMR_HH
+#define INCLUDED_VOLK_PMR_HH
+
+#include <algorithm>
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <vector>
+
+#include <volk/volk.h>
+
+namespace volk {
+namespace pmr {
+
+/*!
+ * \brief Memory resource using volk_malloc_flags and volk_free
+ *
+ * \details
+ *   Every allocation is aligned to at least volk_get_alignment(), whatever
+ *   the requested alignment. Resources with the same flags are equal.
+ */
+class malloc_resource : public std::pmr::memory_resource
+{
+public:
+    explicit malloc_resource(unsigned int flags = 0) noexcept
+        : _flags(flags), _alignment(volk_get_alignment())
+    {
+    }
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        void* p = volk_malloc_flags(
+            std::max<std::size_t>(bytes, 1), std::max(alignment, _alignment), _flags);
+        if (!p)
+            throw std::bad_alloc();
+        return p;
+    }
+
+    void do_deallocate(void* p, std::size_t, std::size_t) override { volk_free(p); }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        auto volk_other = dynamic_cast<const malloc_resource*>(&other);
+        return volk_other && volk_other->_flags == _flags;
+    }
+
+private:
+    unsigned int _flags;
+    std::size_t _alignment;
+};
+
+/*!
+ * \brief Memory resource backed by huge pages, see VOLK_MALLOC_HUGE_PAGES
+ *
+ * \details
+ *   Every allocation is rounded up to whole huge pages, so use it as the
+ *   upstream of an arena or pool rather than for small objects directly.
+ */
+class huge_page_resource : public malloc_resource
+{
+public:
+    huge_page_resource() noexcept : malloc_resource(VOLK_MALLOC_HUGE_PAGES) {}
+};
+
+//! A process wide malloc_resource without flags
+inline malloc_resource* get_malloc_resource() noexcept
+{
+    static malloc_resource resource;
+    return &resource;
+}
+
+//! A process wide huge_page_resource
+inline huge_page_resource* get_huge_page_resource() noexcept
+{
+    static huge_page_resource resource;
+    return &resource;
+}
+
+/*!
+ * \brief Bump allocator aligning every allocation to volk_get_alignment()
+ *
+ * \details
+ *   Wraps std::pmr::monotonic_buffer_resource around a first block of
+ *   \p capacity bytes. Deallocation does nothing; release() frees it all
+ *   at once, in O(1) while the first block was large enough, so per call
+ *   temporaries cost a pointer increment each:
+ *
+ *       volk::pmr::monotonic_arena arena(1 << 20);
+ *       for (;;) {
+ *           volk::pmr::vector<float> mag(n, &arena);
+ *           volk_32fc_magnitude_32f(mag.data(), in, n);
+ *           ...
+ *           arena.release();
+ *       }
+ *
+ *   Not thread safe.
+ */
+class monotonic_arena : public std::pmr::memory_resource
+{
+public:
+    explicit monotonic_arena(std::size_t capacity,
+                             std::pmr::memory_resource* upstream = get_malloc_resource())
+        : _upstream(upstream),
+          _alignment(volk_get_alignment()),
+          _capacity(std::max<std::size_t>(capacity, 1)),
+          _block(upstream->allocate(_capacity, _alignment)),
+          _arena(_block, _capacity, upstream)
+    {
+    }
+    ~monotonic_arena() override
+    {
+        _arena.release();
+        _upstream->deallocate(_block, _capacity, _alignment);
+    }
+
+    monotonic_arena(const monotonic_arena&) = delete;
+    monotonic_arena& operator=(const monotonic_arena&) = delete;
+
+    //! Free every allocation, keeping the first block for reuse
+    void release() { _arena.release(); }
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        return _arena.allocate(bytes, std::max(alignment, _alignment));
+    }
+
+    void do_deallocate(void*, std::size_t, std::size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+private:
+    std::pmr::memory_resource* _upstream;
+    std::size_t _alignment;
+    std::size_t _capacity;
+    void* _block;
+    std::pmr::monotonic_buffer_resource _arena;
+};
+
+/*!
+ * \brief Pool of size classes aligning every block to volk_get_alignment()
+ *
+ * \details
+ *   Wraps std::pmr::unsynchronized_pool_resource, for buffers of a few
+ *   sizes allocated and freed again and again by one thread.
+ */
+class unsynchronized_pool : public std::pmr::memory_resource
+{
+public:
+    explicit unsynchronized_pool(
+        std::pmr::memory_resource* upstream = get_malloc_resource(),
+        const std::pmr::pool_options& options = std::pmr::pool_options())
+        : _alignment(volk_get_alignment()), _pool(options, upstream)
+    {
+    }
+
+    //! Give every block back to the upstream resource
+    void release() { _pool.release(); }
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        return _pool.allocate(bytes, std::max(alignment, _alignment));
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+    {
+        _pool.deallocate(p, bytes, std::max(alignment, _alignment));
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+private:
+    std::size_t _alignment;
+    std::pmr::unsynchronized_pool_resource _pool;
+};
+
+/*!
+ * \brief type alias for std::vector using a polymorphic allocator
+ *
+ * \details
+ *   Aligned for VOLK kernels when constructed with one of the resources
+ *   above, e.g. volk::pmr::vector<float> v(n, &arena). Without one it uses
+ *   std::pmr::get_default_resource(), which only guarantees alignof(T).
+ */
+template <class T>
+using vector = std::vector<T, std::pmr::polymorphic_allocator<T>>;
+
+} // namespace pmr
+} // namespace volk
+
+#endif // INCLUDED_VOLK_PMR_HH
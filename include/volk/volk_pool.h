@@ -0,0 +1,76 @@
+/* -*- c -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of VOLK
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_VOLK_POOL_H
+#define INCLUDED_VOLK_POOL_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <volk/volk_common.h>
+
+__VOLK_DECL_BEGIN
+
+/*!
+ * Totals of the pooled allocator over all threads.
+ *
+ * Counters are kept per thread without locks, volk_pool_get_stats sums
+ * them up. Counts of threads still running may be a few calls behind.
+ */
+typedef struct volk_pool_stats {
+    uint64_t allocations;  // volk_pool_malloc calls that returned memory
+    uint64_t hits;         // allocations served from a thread cache
+    uint64_t misses;       // size class blocks allocated from the system
+    uint64_t large;        // allocations too large or too aligned to pool
+    uint64_t frees;        // volk_pool_free calls with a non-NULL pointer
+    uint64_t releases;     // size class blocks given back to the system
+    uint64_t cached_bytes; // bytes held in the thread caches right now
+    uint64_t threads;      // threads with a cache right now
+} volk_pool_stats_t;
+
+/*!
+ * \brief Allocate \p size bytes aligned to \p alignment from a thread cache.
+ *
+ * \details
+ * Requests are rounded up to power of two size classes from 64 bytes to
+ * 4 MiB. Freed blocks stay in the cache of the thread that freed them
+ * and are handed out again without a system call, so buffers allocated
+ * in every call of a processing function cost a few list operations.
+ * Each thread caches at most VOLK_POOL_MAX_CACHED bytes, 32 MiB unless
+ * set in the environment; blocks beyond that, and the cache of a thread
+ * that exits, go back to the system. Larger sizes and alignments above
+ * 64 bytes are passed on to volk_malloc.
+ *
+ * Memory from volk_pool_malloc must be freed with volk_pool_free, and
+ * memory from volk_malloc with volk_free.
+ *
+ * \param size The number of bytes to allocate.
+ * \param alignment The byte alignment of the allocated memory.
+ * \return pointer to aligned memory, NULL on failure.
+ */
+VOLK_API void* volk_pool_malloc(size_t size, size_t alignment);
+
+/*!
+ * \brief Return memory from volk_pool_malloc to the calling thread's cache.
+ *
+ * \details
+ * The block may come from any thread. NULL is ignored.
+ *
+ * \param ptr The pointer returned by volk_pool_malloc.
+ */
+VOLK_API void volk_pool_free(void* ptr);
+
+//! Give the blocks cached by the calling thread back to the system
+VOLK_API void volk_pool_trim(void);
+
+//! Fill \p stats with the totals of all threads
+VOLK_API void volk_pool_get_stats(volk_pool_stats_t* stats);
+
+__VOLK_DECL_END
+
+#endif /* INCLUDED_VOLK_POOL_H */
@@ -16,6 +16,9 @@
 
 __VOLK_DECL_BEGIN
 
+// maximum number of vector length buckets per kernel in volk_config
+#define VOLK_MAX_LEN_BUCKETS 8
+
 typedef struct volk_arch_pref {
     char name[128];   // name of the kernel
     char impl_a[128]; // best aligned impl
@@ -31,9 +34,33 @@ VOLK_API void volk_get_config_path(char*, bool);
 
 ////////////////////////////////////////////////////////////////////////
 // load prefs into global prefs struct
+//
+// Each volk_config line reads
+//   kernel_name impl_a impl_u [min_points impl_a impl_u]...
+// The first pair applies to all vector lengths. Every optional triple
+// starts a bucket which is used for num_points >= min_points; the
+// buckets are read by libvolk itself and not returned here.
+//
+// A line "[fingerprint]" opens a host section, see
+// volk_get_cpu_fingerprint(). Entries in the section of this host take
+// precedence over the ones before the first section, entries in the
+// sections of other hosts are ignored.
 ////////////////////////////////////////////////////////////////////////
 VOLK_API size_t volk_load_preferences(volk_arch_pref_t**);
 
+////////////////////////////////////////////////////////////////////////
+// parse the kernel name and default implementations of a single
+// volk_config line into a pref struct
+// returns true if the line holds a valid kernel entry
+////////////////////////////////////////////////////////////////////////
+VOLK_API bool volk_parse_preference(const char* line, volk_arch_pref_t* pref);
+
+////////////////////////////////////////////////////////////////////////
+// if the line is a "[fingerprint]" section header copy the fingerprint
+// into the section buffer of the given length and return true
+////////////////////////////////////////////////////////////////////////
+VOLK_API bool volk_parse_section(const char* line, char* section, size_t len);
+
 __VOLK_DECL_END
 
 #endif // INCLUDED_VOLK_PREFS_H
@@ -0,0 +1,64 @@
+/* -*- c -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of VOLK
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_VOLK_STATS_H
+#define INCLUDED_VOLK_STATS_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <volk/volk_common.h>
+
+__VOLK_DECL_BEGIN
+
+//! number of num_points histogram bins, enough for any 32 bit length
+#define VOLK_STATS_HIST_BINS 33
+
+/*!
+ * Call statistics of one kernel, summed over all threads.
+ *
+ * Only collected by libraries built with ENABLE_STATS, the counters
+ * live in the kernel dispatchers. Calls made directly through the _a,
+ * _u or _manual entry points are not counted.
+ */
+typedef struct volk_kernel_stats {
+    const char* name;         // kernel name, e.g. "volk_32f_x2_add_32f"
+    uint64_t calls;           // number of calls through the dispatcher
+    uint64_t points;          // sum of num_points over all calls
+    uint64_t aligned_calls;   // calls with all buffers aligned
+    uint64_t unaligned_calls; // calls with at least one misaligned buffer
+    uint64_t cycles;          // time stamp counter ticks spent in the kernel
+    // hist[0] counts num_points == 0, hist[i] counts 2^(i-1) <= num_points < 2^i
+    uint64_t hist[VOLK_STATS_HIST_BINS];
+} volk_kernel_stats_t;
+
+/*!
+ * \brief Get the call statistics of every kernel called so far.
+ *
+ * Counters are kept per thread without locks, this sums them up. Counts
+ * of threads still running may be a few calls behind.
+ *
+ * \param stats array receiving the statistics, may be NULL
+ * \param max_stats number of entries stats can hold
+ * \return the number of kernels called so far, which may exceed max_stats;
+ *         always 0 if the library was built without ENABLE_STATS
+ */
+VOLK_API size_t volk_get_stats(volk_kernel_stats_t* stats, size_t max_stats);
+
+/*!
+ * \brief Print the call statistics, busiest kernel first.
+ *
+ * Setting VOLK_STATS_DUMP in the environment prints them at exit, to
+ * stderr when empty or "-", else to the file it names.
+ */
+VOLK_API void volk_dump_stats(FILE* file);
+
+__VOLK_DECL_END
+
+#endif /* INCLUDED_VOLK_STATS_H */
@@ -168,6 +168,76 @@ static inline void volk_16ic_convert_32fc_a_avx(lv_32fc_t* outputVector,
 
 #endif /* LV_HAVE_AVX */
 
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static inline void volk_16ic_convert_32fc_a_avx2_nt(lv_32fc_t* outputVector,
+                                                    const lv_16sc_t* inputVector,
+                                                    unsigned int num_points)
+{
+    const unsigned int avx_iters = num_points / 4;
+    unsigned int number = 0;
+    const int16_t* complexVectorPtr = (int16_t*)inputVector;
+    float* outputVectorPtr = (float*)outputVector;
+    __m256 outVal;
+    __m256i outValInt;
+    __m128i cplxValue;
+
+    for (number = 0; number < avx_iters; number++) {
+        cplxValue = _mm_load_si128((__m128i*)complexVectorPtr);
+        complexVectorPtr += 8;
+
+        outValInt = _mm256_cvtepi16_epi32(cplxValue);
+        outVal = _mm256_cvtepi32_ps(outValInt);
+        _mm256_stream_ps((float*)outputVectorPtr, outVal);
+
+        outputVectorPtr += 8;
+    }
+    _mm_sfence();
+
+    number = avx_iters * 8;
+    for (; number < num_points * 2; number++) {
+        *outputVectorPtr++ = (float)*complexVectorPtr++;
+    }
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+#ifdef LV_HAVE_SSE2
+#include <emmintrin.h>
+
+static inline void volk_16ic_convert_32fc_a_sse2_nt(lv_32fc_t* outputVector,
+                                                    const lv_16sc_t* inputVector,
+                                                    unsigned int num_points)
+{
+    const unsigned int sse_iters = num_points / 4;
+    unsigned int number = 0;
+    const int16_t* complexVectorPtr = (int16_t*)inputVector;
+    float* outputVectorPtr = (float*)outputVector;
+    __m128i cplxValue, lo, hi;
+
+    for (number = 0; number < sse_iters; number++) {
+        cplxValue = _mm_load_si128((__m128i*)complexVectorPtr);
+        complexVectorPtr += 8;
+
+        // sign extend each int16 by shifting it down from the upper half
+        lo = _mm_srai_epi32(_mm_unpacklo_epi16(cplxValue, cplxValue), 16);
+        hi = _mm_srai_epi32(_mm_unpackhi_epi16(cplxValue, cplxValue), 16);
+        _mm_stream_ps(outputVectorPtr, _mm_cvtepi32_ps(lo));
+        _mm_stream_ps(outputVectorPtr + 4, _mm_cvtepi32_ps(hi));
+
+        outputVectorPtr += 8;
+    }
+    _mm_sfence();
+
+    number = sse_iters * 8;
+    for (; number < num_points * 2; number++) {
+        *outputVectorPtr++ = (float)*complexVectorPtr++;
+    }
+}
+
+#endif /* LV_HAVE_SSE2 */
+
 
 #ifdef LV_HAVE_NEON
 #include <arm_neon.h>
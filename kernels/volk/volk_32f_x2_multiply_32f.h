@@ -128,9 +128,13 @@ static inline void volk_32f_x2_multiply_32f_u_avx512f(float* cVector,
         cPtr += 16;
     }
 
-    number = sixteenthPoints * 16;
-    for (; number < num_points; number++) {
-        *cPtr++ = (*aPtr++) * (*bPtr++);
+    // the last points in one vector, masked off lanes are not accessed
+    const __mmask16 tail = (__mmask16)((1u << (num_points % 16)) - 1);
+    if (tail) {
+        aVal = _mm512_maskz_loadu_ps(tail, aPtr);
+        bVal = _mm512_maskz_loadu_ps(tail, bPtr);
+        cVal = _mm512_mul_ps(aVal, bVal);
+        _mm512_mask_storeu_ps(cPtr, tail, cVal);
     }
 }
 #endif /* LV_HAVE_AVX512F */
@@ -172,6 +176,37 @@ static inline void volk_32f_x2_multiply_32f_u_avx(float* cVector,
 }
 #endif /* LV_HAVE_AVX */
 
+#ifdef LV_HAVE_AVX
+
+static inline void volk_32f_x2_multiply_32f_u_avx_padded(float* cVector,
+                                                         const float* aVector,
+                                                         const float* bVector,
+                                                         unsigned int num_points)
+{
+    // the buffers are padded, so the last vector may run past num_points
+    const unsigned int vectors = num_points / 8 + (num_points % 8 != 0);
+
+    float* cPtr = cVector;
+    const float* aPtr = aVector;
+    const float* bPtr = bVector;
+
+    __m256 aVal, bVal, cVal;
+    for (unsigned int number = 0; number < vectors; number++) {
+
+        aVal = _mm256_loadu_ps(aPtr);
+        bVal = _mm256_loadu_ps(bPtr);
+
+        cVal = _mm256_mul_ps(aVal, bVal);
+
+        _mm256_storeu_ps(cPtr, cVal);
+
+        aPtr += 8;
+        bPtr += 8;
+        cPtr += 8;
+    }
+}
+#endif /* LV_HAVE_AVX */
+
 
 #ifdef LV_HAVE_GENERIC
 
@@ -268,9 +303,13 @@ static inline void volk_32f_x2_multiply_32f_a_avx512f(float* cVector,
         cPtr += 16;
     }
 
-    number = sixteenthPoints * 16;
-    for (; number < num_points; number++) {
-        *cPtr++ = (*aPtr++) * (*bPtr++);
+    // the last points in one vector, masked off lanes are not accessed
+    const __mmask16 tail = (__mmask16)((1u << (num_points % 16)) - 1);
+    if (tail) {
+        aVal = _mm512_maskz_load_ps(tail, aPtr);
+        bVal = _mm512_maskz_load_ps(tail, bPtr);
+        cVal = _mm512_mul_ps(aVal, bVal);
+        _mm512_mask_store_ps(cPtr, tail, cVal);
     }
 }
 #endif /* LV_HAVE_AVX512F */
@@ -313,6 +352,37 @@ static inline void volk_32f_x2_multiply_32f_a_avx(float* cVector,
 }
 #endif /* LV_HAVE_AVX */
 
+#ifdef LV_HAVE_AVX
+
+static inline void volk_32f_x2_multiply_32f_a_avx_padded(float* cVector,
+                                                         const float* aVector,
+                                                         const float* bVector,
+                                                         unsigned int num_points)
+{
+    // the buffers are padded, so the last vector may run past num_points
+    const unsigned int vectors = num_points / 8 + (num_points % 8 != 0);
+
+    float* cPtr = cVector;
+    const float* aPtr = aVector;
+    const float* bPtr = bVector;
+
+    __m256 aVal, bVal, cVal;
+    for (unsigned int number = 0; number < vectors; number++) {
+
+        aVal = _mm256_load_ps(aPtr);
+        bVal = _mm256_load_ps(bPtr);
+
+        cVal = _mm256_mul_ps(aVal, bVal);
+
+        _mm256_store_ps(cPtr, cVal);
+
+        aPtr += 8;
+        bPtr += 8;
+        cPtr += 8;
+    }
+}
+#endif /* LV_HAVE_AVX */
+
 
 #ifdef LV_HAVE_NEON
 #include <arm_neon.h>
@@ -0,0 +1,124 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of VOLK
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "qa_perf_counters.h"
+
+#if defined(__linux__)
+#include <linux/perf_event.h> // for perf_event_attr, PERF_*
+#include <sys/ioctl.h>        // for ioctl
+#include <sys/syscall.h>      // for SYS_perf_event_open
+#include <unistd.h>           // for syscall, close, read
+#endif
+#include <cerrno>   // for errno
+#include <cstring>  // for memset, strerror
+#include <iostream> // for cerr
+
+#if defined(__linux__)
+static int perf_event_open(uint32_t type, uint64_t config, int group_fd)
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = group_fd < 0;
+    // user space only, which perf_event_paranoid up to 2 allows
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID |
+                       PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0);
+}
+#endif
+
+volk_qa_perf_counters::volk_qa_perf_counters() : _running_ns(0.0)
+{
+    for (int e = 0; e < N_EVENTS; e++) {
+        _fds[e] = -1;
+        _ids[e] = 0;
+        _counts[e] = -1.0;
+    }
+#if defined(__linux__)
+    const uint32_t types[N_EVENTS] = {
+        PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE
+    };
+    const uint64_t configs[N_EVENTS] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+            (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+        PERF_COUNT_HW_CACHE_MISSES
+    };
+    static bool warned = false;
+    for (int e = 0; e < N_EVENTS; e++) {
+        // the cycles counter leads the group, the others are optional
+        _fds[e] = perf_event_open(types[e], configs[e], e == CYCLES ? -1 : _fds[CYCLES]);
+        if (_fds[CYCLES] < 0) {
+            if (!warned) {
+                std::cerr << "Warning: no performance counters (" << strerror(errno)
+                          << "), check /proc/sys/kernel/perf_event_paranoid"
+                          << std::endl;
+                warned = true;
+            }
+            return;
+        }
+        if (_fds[e] >= 0) {
+            ioctl(_fds[e], PERF_EVENT_IOC_ID, &_ids[e]);
+        }
+    }
+#endif
+}
+
+volk_qa_perf_counters::~volk_qa_perf_counters()
+{
+#if defined(__linux__)
+    for (int e = N_EVENTS - 1; e >= 0; e--) {
+        if (_fds[e] >= 0) {
+            close(_fds[e]);
+        }
+    }
+#endif
+}
+
+void volk_qa_perf_counters::start()
+{
+#if defined(__linux__)
+    if (available()) {
+        ioctl(_fds[CYCLES], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+#endif
+}
+
+void volk_qa_perf_counters::stop()
+{
+#if defined(__linux__)
+    if (!available()) {
+        return;
+    }
+    ioctl(_fds[CYCLES], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+    // nr, time_enabled, time_running, then a value and id per event
+    uint64_t data[3 + 2 * N_EVENTS];
+    if (read(_fds[CYCLES], data, sizeof(data)) < (ssize_t)(3 * sizeof(uint64_t))) {
+        return;
+    }
+    // the times of a thread's counters only advance while it runs
+    const uint64_t enabled = data[1];
+    const uint64_t running = data[2];
+    _running_ns = (double)enabled;
+    for (int e = 0; e < N_EVENTS; e++) {
+        _counts[e] = -1.0;
+        for (uint64_t i = 0; i < data[0] && i < N_EVENTS; i++) {
+            if (_fds[e] >= 0 && data[4 + 2 * i] == _ids[e] && running > 0) {
+                _counts[e] = (double)data[3 + 2 * i] * enabled / running;
+            }
+        }
+    }
+#endif
+}
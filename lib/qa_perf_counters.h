@@ -0,0 +1,48 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of VOLK
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef VOLK_QA_PERF_COUNTERS_H
+#define VOLK_QA_PERF_COUNTERS_H
+
+#include <stdint.h> // for uint64_t
+
+/************************************************
+ * Hardware performance counters of the calling *
+ * thread, read with Linux perf_event_open      *
+ ************************************************/
+class volk_qa_perf_counters
+{
+public:
+    enum event { CYCLES, INSTRUCTIONS, L1D_MISSES, LLC_MISSES, N_EVENTS };
+
+    volk_qa_perf_counters();
+    ~volk_qa_perf_counters();
+    volk_qa_perf_counters(const volk_qa_perf_counters&) = delete;
+    volk_qa_perf_counters& operator=(const volk_qa_perf_counters&) = delete;
+
+    //! false when the kernel refuses the counters, e.g. under perf_event_paranoid
+    bool available() const { return _fds[CYCLES] >= 0; }
+    //! start or resume counting, counts add up over start and stop pairs
+    void start();
+    //! stop counting and read the counts so far
+    void stop();
+
+    //! count of an event while started, scaled if multiplexed, -1 if not counted
+    double count(event e) const { return _counts[e]; }
+    //! nanoseconds the thread ran while counting
+    double running_ns() const { return _running_ns; }
+
+private:
+    int _fds[N_EVENTS];
+    uint64_t _ids[N_EVENTS];
+    double _counts[N_EVENTS];
+    double _running_ns;
+};
+
+#endif // VOLK_QA_PERF_COUNTERS_H
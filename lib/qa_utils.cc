@@ -8,37 +8,197 @@
  */
 
 #include "qa_utils.h"
+#include "qa_perf_counters.h"
 #include <volk/volk.h>
 
 #include <volk/volk.h>        // for volk_func_desc_t
 #include <volk/volk_malloc.h> // for volk_free, volk_m...
 
-#include <assert.h>    // for assert
-#include <stdint.h>    // for uint16_t, uint64_t
-#include <sys/time.h>  // for CLOCKS_PER_SEC
-#include <sys/types.h> // for int16_t, int32_t
-#include <chrono>
-#include <cmath>    // for sqrt, fabs, abs
-#include <cstring>  // for memcpy, memset
-#include <ctime>    // for clock
-#include <fstream>  // for operator<<, basic...
-#include <iostream> // for cout, cerr
-#include <limits>   // for numeric_limits
-#include <map>      // for map, map<>::mappe...
-#include <random>
-#include <vector> // for vector, _Bit_refe...
+#include <assert.h>           // for assert
+#include <stdint.h>           // for uint16_t, uint64_t
+#include <sys/time.h>         // for CLOCKS_PER_SEC
+#include <sys/types.h>        // for int16_t, int32_t
+#include <algorithm>          // for sort, min, max
+#include <chrono>             // for steady_clock
+#include <cmath>              // for sqrt, fabs, abs
+#include <condition_variable> // for condition_variable
+#include <cstring>            // for memcpy, memset
+#include <ctime>              // for clock
+#include <fstream>            // for operator<<, basic...
+#include <functional>         // for function
+#include <iostream>           // for cout, cerr
+#include <limits>             // for numeric_limits
+#include <map>                // for map, map<>::mappe...
+#include <memory>             // for unique_ptr
+#include <mutex>              // for mutex, unique_lock
+#include <new>                // for bad_alloc
+#include <random>             // for default_random_engine, ...
+#include <thread>             // for thread
+#include <vector>             // for vector, _Bit_refe...
 
+#if defined(__linux__)
+#include <sched.h> // for sched_setaffinity
+#endif
+
+static const char* const input_names[] = { "uniform", "gaussian", "qpsk",     "qam16",
+                                           "tone",    "sorted",   "denormal", "edge" };
+
+bool volk_test_input_from_string(const std::string& name, volk_test_input_t& input)
+{
+    for (size_t i = 0; i < sizeof(input_names) / sizeof(input_names[0]); i++) {
+        if (name == input_names[i]) {
+            input = (volk_test_input_t)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string volk_test_input_name(volk_test_input_t input) { return input_names[input]; }
+
+std::string volk_test_input_names(void)
+{
+    std::string names;
+    for (size_t i = 0; i < sizeof(input_names) / sizeof(input_names[0]); i++) {
+        names += (i ? "," : "") + std::string(input_names[i]);
+    }
+    return names;
+}
+
+// n samples nominally within [-1, 1], complex ones as interleaved pairs
 template <typename T>
-void random_floats(void* buf, unsigned int n, std::default_random_engine& rnd_engine)
+static void random_floats(T* array,
+                          unsigned int n,
+                          bool is_complex,
+                          volk_test_input_t input,
+                          std::default_random_engine& rnd_engine)
 {
-    T* array = static_cast<T*>(buf);
+    typedef std::numeric_limits<T> limits;
+    const unsigned int components = is_complex ? 2 : 1;
     std::uniform_real_distribution<T> uniform_dist(T(-1), T(1));
+    switch (input) {
+    case VOLK_TEST_INPUT_GAUSSIAN: {
+        std::normal_distribution<T> normal_dist(T(0), T(1) / T(3));
+        for (unsigned int i = 0; i < n; i++) {
+            array[i] = normal_dist(rnd_engine);
+        }
+        break;
+    }
+    case VOLK_TEST_INPUT_QPSK:
+    case VOLK_TEST_INPUT_QAM16: {
+        // levels of one component, real data holds in-phase components only
+        const int levels = input == VOLK_TEST_INPUT_QPSK ? 2 : 4;
+        const double scale = 1.0 / std::sqrt(input == VOLK_TEST_INPUT_QPSK ? 2.0 : 10.0);
+        std::uniform_int_distribution<int> level_dist(0, levels - 1);
+        for (unsigned int i = 0; i < n; i++) {
+            array[i] = T(scale * (2 * level_dist(rnd_engine) - (levels - 1)));
+        }
+        break;
+    }
+    case VOLK_TEST_INPUT_TONE: {
+        // a frequency whose period is no multiple of any SIMD width
+        const double pi = 3.14159265358979323846;
+        const double step = 2.0 * pi * 0.0123;
+        double phase = pi * uniform_dist(rnd_engine);
+        for (unsigned int i = 0; i + components <= n; i += components) {
+            array[i] = T(std::cos(phase));
+            if (is_complex) {
+                array[i + 1] = T(std::sin(phase));
+            }
+            phase += step;
+        }
+        break;
+    }
+    case VOLK_TEST_INPUT_SORTED: {
+        const unsigned int last = std::max(n / components, 2u) - 1;
+        for (unsigned int i = 0; i < n; i++) {
+            array[i] = T(-1.0 + 2.0 * (i / components) / last);
+        }
+        break;
+    }
+    case VOLK_TEST_INPUT_DENORMAL:
+        for (unsigned int i = 0; i < n; i++) {
+            array[i] = uniform_dist(rnd_engine) * limits::min();
+        }
+        break;
+    case VOLK_TEST_INPUT_EDGE: {
+        const T edges[] = { T(0),
+                            -T(0),
+                            T(1),
+                            T(-1),
+                            limits::max(),
+                            limits::lowest(),
+                            limits::min(),
+                            -limits::min(),
+                            limits::denorm_min(),
+                            -limits::denorm_min(),
+                            limits::infinity(),
+                            -limits::infinity(),
+                            limits::quiet_NaN() };
+        std::uniform_int_distribution<size_t> edge_dist(
+            0, sizeof(edges) / sizeof(edges[0]) - 1);
+        for (unsigned int i = 0; i < n; i++) {
+            array[i] = edges[edge_dist(rnd_engine)];
+        }
+        break;
+    }
+    default:
+        for (unsigned int i = 0; i < n; i++) {
+            array[i] = uniform_dist(rnd_engine);
+        }
+        break;
+    }
+}
+
+// samples of random_floats scaled to the range of an integer type. 16-bit
+// data stays within +-7 like the uniform data, so that the kernels which
+// accumulate 16-bit values do not overflow.
+template <typename T>
+static void random_integers(T* array,
+                            unsigned int n,
+                            bool is_complex,
+                            volk_test_input_t input,
+                            std::default_random_engine& rnd_engine)
+{
+    typedef std::numeric_limits<T> limits;
+    if (input == VOLK_TEST_INPUT_EDGE) {
+        const T edges[] = { limits::lowest(), T(limits::lowest() + 1), T(0), T(1),
+                            T(-1),            T(limits::max() - 1),    limits::max() };
+        std::uniform_int_distribution<size_t> edge_dist(
+            0, sizeof(edges) / sizeof(edges[0]) - 1);
+        for (unsigned int i = 0; i < n; i++) {
+            array[i] = edges[edge_dist(rnd_engine)];
+        }
+        return;
+    }
+    if (input == VOLK_TEST_INPUT_DENORMAL) {
+        // integers have no subnormals, the smallest magnitudes stand in
+        std::uniform_int_distribution<int> small_dist(limits::is_signed ? -1 : 0, 1);
+        for (unsigned int i = 0; i < n; i++) {
+            array[i] = T(small_dist(rnd_engine));
+        }
+        return;
+    }
+    std::vector<double> samples(n);
+    random_floats<double>(samples.data(), n, is_complex, input, rnd_engine);
+    const double scale = sizeof(T) == 2 ? 7.0 : double(limits::max());
     for (unsigned int i = 0; i < n; i++) {
-        array[i] = uniform_dist(rnd_engine);
+        const double sample = limits::is_signed ? samples[i] : (samples[i] + 1.0) / 2.0;
+        const double value = std::round(sample * scale);
+        if (value >= double(limits::max())) {
+            array[i] = limits::max();
+        } else if (value <= double(limits::lowest())) {
+            array[i] = limits::lowest();
+        } else {
+            array[i] = T(value);
+        }
     }
 }
 
-void load_random_data(void* data, volk_type_t type, unsigned int n)
+void load_random_data(void* data,
+                      volk_type_t type,
+                      unsigned int n,
+                      volk_test_input_t input)
 {
     std::random_device rnd_device;
     std::default_random_engine rnd_engine(rnd_device());
@@ -46,9 +206,38 @@ void load_random_data(void* data, volk_type_t type, unsigned int n)
         n *= 2;
     if (type.is_float) {
         if (type.size == 8) {
-            random_floats<double>(data, n, rnd_engine);
+            random_floats<double>((double*)data, n, type.is_complex, input, rnd_engine);
         } else {
-            random_floats<float>(data, n, rnd_engine);
+            random_floats<float>((float*)data, n, type.is_complex, input, rnd_engine);
+        }
+    } else if (input != VOLK_TEST_INPUT_UNIFORM) {
+        switch (type.size) {
+        case 8:
+            if (type.is_signed)
+                random_integers((int64_t*)data, n, type.is_complex, input, rnd_engine);
+            else
+                random_integers((uint64_t*)data, n, type.is_complex, input, rnd_engine);
+            break;
+        case 4:
+            if (type.is_signed)
+                random_integers((int32_t*)data, n, type.is_complex, input, rnd_engine);
+            else
+                random_integers((uint32_t*)data, n, type.is_complex, input, rnd_engine);
+            break;
+        case 2:
+            if (type.is_signed)
+                random_integers((int16_t*)data, n, type.is_complex, input, rnd_engine);
+            else
+                random_integers((uint16_t*)data, n, type.is_complex, input, rnd_engine);
+            break;
+        case 1:
+            if (type.is_signed)
+                random_integers((int8_t*)data, n, type.is_complex, input, rnd_engine);
+            else
+                random_integers((uint8_t*)data, n, type.is_complex, input, rnd_engine);
+            break;
+        default:
+            throw "load_random_data: no support for data size > 8 or < 1";
         }
     } else {
         float int_max = float(uint64_t(2) << (type.size * 8));
@@ -93,13 +282,21 @@ void load_random_data(void* data, volk_type_t type, unsigned int n)
     }
 }
 
-static std::vector<std::string> get_arch_list(volk_func_desc_t desc)
+// the implementations of desc followed by their padded twins, which are
+// tested but never ranked
+static std::vector<std::string> get_arch_list(volk_func_desc_t desc,
+                                              const std::string& name)
 {
     std::vector<std::string> archlist;
 
     for (size_t i = 0; i < desc.n_impls; i++) {
         archlist.push_back(std::string(desc.impl_names[i]));
     }
+    for (size_t i = 0; i < desc.n_impls; i++) {
+        if (volk_has_padded_impl(name.c_str(), desc.impl_names[i])) {
+            archlist.push_back(std::string(desc.impl_names[i]) + "_padded");
+        }
+    }
 
     return archlist;
 }
@@ -249,6 +446,20 @@ static void get_signatures_from_name(std::vector<volk_type_t>& inputsig,
     assert(inputsig.size() != 0);
 }
 
+size_t volk_test_bytes_per_point(std::string name)
+{
+    std::vector<volk_type_t> inputsig, outputsig;
+    get_signatures_from_name(inputsig, outputsig, name);
+    size_t bytes = 0;
+    for (const auto& sig : inputsig) {
+        bytes += sig.is_scalar ? 0 : sig.size * (sig.is_complex ? 2 : 1);
+    }
+    for (const auto& sig : outputsig) {
+        bytes += sig.size * (sig.is_complex ? 2 : 1);
+    }
+    return bytes;
+}
+
 inline void run_cast_test1(volk_fn_1arg func,
                            std::vector<void*>& buffs,
                            unsigned int vlen,
@@ -478,10 +689,23 @@ bool icompare(t* in1, t* in2, unsigned int vlen, unsigned int tol, bool absolute
 class volk_qa_aligned_mem_pool
 {
 public:
+    // node < 0 allocates with volk_malloc, else on that NUMA node. Every
+    // buffer is padded by VOLK_PADDING bytes for the padded twins.
+    volk_qa_aligned_mem_pool(int node = -1) : _node(node) {}
     void* get_new(size_t size)
     {
         size_t alignment = volk_get_alignment();
-        void* ptr = volk_malloc(size, alignment);
+        void* ptr = _node < 0
+                        ? volk_malloc_flags(size, alignment, VOLK_MALLOC_PADDED)
+                        : volk_malloc_onnode(size + VOLK_PADDING, alignment, _node);
+        if (!ptr) {
+            std::cerr << "Error: unable to allocate a " << size << " byte test buffer";
+            if (_node >= 0) {
+                std::cerr << " on NUMA node " << _node;
+            }
+            std::cerr << std::endl;
+            throw std::bad_alloc();
+        }
         memset(ptr, 0x00, size);
         _mems.push_back(ptr);
         return ptr;
@@ -494,46 +718,363 @@ public:
     }
 
 private:
+    int _node;
     std::vector<void*> _mems;
 };
 
+// pins the calling thread to one CPU while in scope, cpu < 0 leaves it alone
+class volk_qa_cpu_pin
+{
+public:
+    volk_qa_cpu_pin(int cpu) : _pinned(false)
+    {
+        if (cpu < 0) {
+            return;
+        }
+#if defined(__linux__)
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(cpu, &cpus);
+        _pinned = sched_getaffinity(0, sizeof(_old_cpus), &_old_cpus) == 0 &&
+                  sched_setaffinity(0, sizeof(cpus), &cpus) == 0;
+#endif
+        if (!_pinned) {
+            std::cerr << "Warning: cannot pin to CPU " << cpu << std::endl;
+        }
+    }
+    ~volk_qa_cpu_pin()
+    {
+#if defined(__linux__)
+        if (_pinned) {
+            sched_setaffinity(0, sizeof(_old_cpus), &_old_cpus);
+        }
+#endif
+    }
+
+private:
+    bool _pinned;
+#if defined(__linux__)
+    cpu_set_t _old_cpus;
+#endif
+};
+
+static double sorted_percentile(const std::vector<double>& sorted, double percent)
+{
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    // nearest rank
+    size_t rank = (size_t)std::ceil(percent / 100.0 * sorted.size());
+    return sorted[std::min(std::max(rank, (size_t)1), sorted.size()) - 1];
+}
+
+static void summarize_samples(std::vector<double> samples, volk_test_time_t& result)
+{
+    result.samples = samples.size();
+    result.time = 0.0;
+    for (double sample : samples) {
+        result.time += sample;
+    }
+    std::sort(samples.begin(), samples.end());
+    result.median = sorted_percentile(samples, 50.0);
+    result.p90 = sorted_percentile(samples, 90.0);
+    result.p99 = sorted_percentile(samples, 99.0);
+    result.cv = 0.0;
+    if (samples.size() > 1 && result.time > 0.0) {
+        double mean = result.time / samples.size();
+        double sum_sq = 0.0;
+        for (double sample : samples) {
+            sum_sq += (sample - mean) * (sample - mean);
+        }
+        result.cv = std::sqrt(sum_sq / (samples.size() - 1)) / mean;
+    }
+}
+
+static void read_counters(const volk_qa_perf_counters& counters,
+                          double calls,
+                          volk_test_time_t& result)
+{
+    auto per_call = [&](volk_qa_perf_counters::event e) {
+        const double count = counters.count(e);
+        return count < 0.0 || calls == 0.0 ? -1.0 : count / calls;
+    };
+    result.has_counters = true;
+    result.cycles = per_call(volk_qa_perf_counters::CYCLES);
+    result.instructions = per_call(volk_qa_perf_counters::INSTRUCTIONS);
+    result.l1d_misses = per_call(volk_qa_perf_counters::L1D_MISSES);
+    result.llc_misses = per_call(volk_qa_perf_counters::LLC_MISSES);
+    result.ipc = result.cycles > 0.0 && result.instructions >= 0.0
+                     ? result.instructions / result.cycles
+                     : -1.0;
+    const double cycles = counters.count(volk_qa_perf_counters::CYCLES);
+    const double running_ns = counters.running_ns();
+    result.ghz = cycles >= 0.0 && running_ns > 0.0 ? cycles / running_ns : -1.0;
+}
+
+/*
+ * True when the times in a are significantly lower than those in b,
+ * by a one sided Mann-Whitney U test at the 1% level. With too few
+ * samples for the test the medians are compared instead.
+ */
+static bool significantly_faster(const std::vector<double>& a,
+                                 const std::vector<double>& b)
+{
+    const size_t min_samples = 8;
+    if (a.size() < min_samples || b.size() < min_samples) {
+        std::vector<double> sorted_a(a), sorted_b(b);
+        std::sort(sorted_a.begin(), sorted_a.end());
+        std::sort(sorted_b.begin(), sorted_b.end());
+        return sorted_percentile(sorted_a, 50.0) < sorted_percentile(sorted_b, 50.0);
+    }
+
+    // rank both samples together, ties get the mean of their ranks
+    std::vector<std::pair<double, bool>> all;
+    for (double sample : a) {
+        all.push_back(std::make_pair(sample, true));
+    }
+    for (double sample : b) {
+        all.push_back(std::make_pair(sample, false));
+    }
+    std::sort(all.begin(), all.end());
+    double rank_sum_a = 0.0;
+    for (size_t first = 0; first < all.size();) {
+        size_t last = first;
+        while (last + 1 < all.size() && all[last + 1].first == all[first].first) {
+            last++;
+        }
+        double rank = (first + last) / 2.0 + 1.0;
+        for (size_t ii = first; ii <= last; ii++) {
+            rank_sum_a += all[ii].second ? rank : 0.0;
+        }
+        first = last + 1;
+    }
+
+    const double n_a = a.size();
+    const double n_b = b.size();
+    const double u_a = rank_sum_a - n_a * (n_a + 1.0) / 2.0;
+    const double sigma = std::sqrt(n_a * n_b * (n_a + n_b + 1.0) / 12.0);
+    const double z = (u_a - n_a * n_b / 2.0) / sigma;
+    return z < -2.326;
+}
+
+static unsigned int count_deps(int deps)
+{
+    unsigned int count = 0;
+    for (unsigned int bits = (unsigned int)deps; bits; bits &= bits - 1) {
+        count++;
+    }
+    return count;
+}
+
+/*
+ * Pick the arch with the lowest median among the candidates. Archs that are
+ * not significantly slower than it are tied with it, and of those the one
+ * needing the fewest instruction set features wins so that noise does not
+ * flip the choice between runs. tied gets every arch of the tie, the winner
+ * included.
+ */
+static size_t pick_best_arch(const std::vector<size_t>& candidates,
+                             const std::vector<std::vector<double>>& samples,
+                             const std::vector<double>& medians,
+                             const volk_func_desc_t& desc,
+                             std::vector<size_t>& tied)
+{
+    size_t fastest = candidates[0];
+    for (size_t arch : candidates) {
+        if (medians[arch] < medians[fastest]) {
+            fastest = arch;
+        }
+    }
+    tied.clear();
+    size_t best = fastest;
+    for (size_t arch : candidates) {
+        if (arch != fastest && significantly_faster(samples[fastest], samples[arch])) {
+            continue;
+        }
+        tied.push_back(arch);
+        const unsigned int deps = count_deps(desc.impl_deps[arch]);
+        const unsigned int best_deps = count_deps(desc.impl_deps[best]);
+        if (deps < best_deps || (deps == best_deps && medians[arch] < medians[best])) {
+            best = arch;
+        }
+    }
+    return best;
+}
+
+/*
+ * Half width of a 95% confidence interval on the median, from the order
+ * statistics around it, relative to the median.
+ */
+static double median_ci_width(std::vector<double> samples)
+{
+    if (samples.size() < 2) {
+        return std::numeric_limits<double>::max();
+    }
+    std::sort(samples.begin(), samples.end());
+    const double n = samples.size();
+    const double spread = 0.98 * std::sqrt(n);
+    const size_t lo = (size_t)std::max(std::floor(n / 2.0 - spread), 0.0);
+    const size_t hi = (size_t)std::min(std::ceil(n / 2.0 + spread), n - 1.0);
+    const double median = sorted_percentile(samples, 50.0);
+    return median > 0.0 ? (samples[hi] - samples[lo]) / (2.0 * median)
+                        : std::numeric_limits<double>::max();
+}
+
+/*
+ * Time the archs in rounds until their ranking is settled rather than for a
+ * fixed number of calls. Every round adds calls to the archs still in the
+ * race. An arch drops out once it is significantly slower than the fastest
+ * arch of each ranking it takes part in, the aligned one and for unaligned
+ * archs the unaligned one. Timing stops when no arch is tied with a leader
+ * any more, when the medians of the archs left are known to within
+ * target_ci, or when they reached max_samples calls.
+ */
+static void
+time_until_settled(const volk_func_desc_t& desc,
+                   std::vector<std::vector<double>>& samples,
+                   unsigned int max_samples,
+                   const std::function<void(size_t, unsigned int)>& time_calls)
+{
+    const unsigned int min_samples = std::min(16u, max_samples);
+    const double target_ci = 0.02;
+    const size_t n_archs = samples.size();
+    // padded twins beyond the implementations of desc are timed, not raced
+    std::vector<bool> racing(n_archs, false);
+    for (size_t i = 0; i < n_archs && i < desc.n_impls; i++) {
+        racing[i] = true;
+    }
+    // short turns spread slow drifts of the clock rate evenly over the archs
+    const unsigned int turn = 4;
+    for (unsigned int timed = 0; timed < min_samples; timed += turn) {
+        for (size_t i = 0; i < n_archs; i++) {
+            time_calls(i, std::min(turn, min_samples - timed));
+        }
+    }
+
+    while (true) {
+        std::vector<double> medians(n_archs);
+        for (size_t i = 0; i < n_archs; i++) {
+            std::vector<double> sorted(samples[i]);
+            std::sort(sorted.begin(), sorted.end());
+            medians[i] = sorted_percentile(sorted, 50.0);
+        }
+        size_t leader_a = n_archs, leader_u = n_archs;
+        for (size_t i = 0; i < n_archs; i++) {
+            if (!racing[i]) {
+                continue;
+            }
+            if (leader_a == n_archs || medians[i] < medians[leader_a]) {
+                leader_a = i;
+            }
+            if (desc.impl_alignment[i] == 0 &&
+                (leader_u == n_archs || medians[i] < medians[leader_u])) {
+                leader_u = i;
+            }
+        }
+
+        bool settled = true;
+        bool tight = true;
+        for (size_t i = 0; i < n_archs; i++) {
+            if (!racing[i] || i == leader_a || i == leader_u) {
+                continue;
+            }
+            const bool loses_a = significantly_faster(samples[leader_a], samples[i]);
+            const bool loses_u = desc.impl_alignment[i] != 0 ||
+                                 significantly_faster(samples[leader_u], samples[i]);
+            if (loses_a && loses_u) {
+                racing[i] = false;
+            } else {
+                settled = false;
+            }
+        }
+        for (size_t i = 0; i < n_archs; i++) {
+            if (racing[i] && median_ci_width(samples[i]) > target_ci) {
+                tight = false;
+            }
+        }
+        if (settled || tight) {
+            return;
+        }
+
+        // rounds grow geometrically so that close races take few of them
+        std::vector<size_t> targets(n_archs);
+        bool capped = true;
+        for (size_t i = 0; i < n_archs; i++) {
+            const size_t timed = samples[i].size();
+            targets[i] = racing[i] ? std::min<size_t>(timed + timed / 2, max_samples) : 0;
+            capped = capped && targets[i] <= timed;
+        }
+        if (capped) {
+            return;
+        }
+        for (bool more = true; more;) {
+            more = false;
+            for (size_t i = 0; i < n_archs; i++) {
+                if (samples[i].size() < targets[i]) {
+                    time_calls(i, std::min<size_t>(turn, targets[i] - samples[i].size()));
+                    more = true;
+                }
+            }
+        }
+    }
+}
+
 bool run_volk_tests(volk_func_desc_t desc,
                     void (*manual_func)(),
                     std::string name,
-                    volk_test_params_t test_params,
+                    float tol,
+                    lv_32fc_t scalar,
+                    unsigned int vlen,
+                    unsigned int iter,
                     std::vector<volk_test_results_t>* results,
-                    std::string puppet_master_name)
+                    std::string puppet_master_name,
+                    bool absolute_mode,
+                    bool benchmark_mode)
 {
+    volk_test_params_t test_params(tol, scalar, vlen, iter, benchmark_mode, "");
     return run_volk_tests(desc,
                           manual_func,
                           name,
-                          test_params.tol(),
-                          test_params.scalar(),
-                          test_params.vlen(),
-                          test_params.iter(),
+                          absolute_mode ? test_params.make_absolute(tol) : test_params,
                           results,
-                          puppet_master_name,
-                          test_params.absolute_mode(),
-                          test_params.benchmark_mode());
+                          puppet_master_name);
 }
 
 bool run_volk_tests(volk_func_desc_t desc,
                     void (*manual_func)(),
                     std::string name,
-                    float tol,
-                    lv_32fc_t scalar,
-                    unsigned int vlen,
-                    unsigned int iter,
+                    volk_test_params_t test_params,
                     std::vector<volk_test_results_t>* results,
-                    std::string puppet_master_name,
-                    bool absolute_mode,
-                    bool benchmark_mode)
+                    std::string puppet_master_name)
 {
+    const float tol = test_params.tol();
+    const lv_32fc_t scalar = test_params.scalar();
+    unsigned int vlen = test_params.vlen();
+    const unsigned int iter = test_params.iter();
+    const bool absolute_mode = test_params.absolute_mode();
+    const bool benchmark_mode = test_params.benchmark_mode();
+    const unsigned int warmup = test_params.warmup();
+    const int pin_cpu = test_params.pin_cpu();
+    const unsigned int buffer_sets = test_params.buffer_sets();
+    const bool perf_counters = test_params.perf_counters();
+    const unsigned int threads = test_params.threads();
+    const bool rank_aggregate = test_params.rank_aggregate();
+    const bool adaptive = test_params.adaptive();
+    const volk_test_input_t input = test_params.input();
+    const int mem_node = test_params.mem_node();
+
     // Initialize this entry in results vector
     results->push_back(volk_test_results_t());
     results->back().name = name;
     results->back().vlen = vlen;
     results->back().iter = iter;
+    results->back().warmup = warmup;
+    results->back().pin_cpu = pin_cpu;
+    results->back().threads = std::max(threads, 1u);
+    results->back().rank_aggregate = rank_aggregate && threads > 1;
+    results->back().adaptive = adaptive;
+    results->back().input = volk_test_input_name(input);
+    results->back().mem_node = mem_node;
     std::cout << "RUN_VOLK_TESTS: " << name << "(" << vlen << "," << iter << ")"
               << std::endl;
 
@@ -547,7 +1088,7 @@ bool run_volk_tests(volk_func_desc_t desc,
     const unsigned int tol_i = static_cast<const unsigned int>(tol);
 
     // first let's get a list of available architectures for the test
-    std::vector<std::string> arch_list = get_arch_list(desc);
+    std::vector<std::string> arch_list = get_arch_list(desc, name);
 
     if ((!benchmark_mode) && (arch_list.size() < 2)) {
         std::cout << "no architectures to test" << std::endl;
@@ -555,7 +1096,7 @@ bool run_volk_tests(volk_func_desc_t desc,
     }
 
     // something that can hang onto memory and cleanup when this function exits
-    volk_qa_aligned_mem_pool mem_pool;
+    volk_qa_aligned_mem_pool mem_pool(mem_node);
 
     // now we have to get a function signature by parsing the name
     std::vector<volk_type_t> inputsig, outputsig;
@@ -578,35 +1119,57 @@ bool run_volk_tests(volk_func_desc_t desc,
         }
     }
     std::vector<void*> inbuffs;
-    for (unsigned int inputsig_index = 0; inputsig_index < inputsig.size();
-         ++inputsig_index) {
-        volk_type_t sig = inputsig[inputsig_index];
-        if (!sig.is_scalar) // we don't make buffers for scalars
-            inbuffs.push_back(
-                mem_pool.get_new(vlen * sig.size * (sig.is_complex ? 2 : 1)));
-    }
-    for (size_t i = 0; i < inbuffs.size(); i++) {
-        load_random_data(inbuffs[i], inputsig[i], vlen);
-    }
-
-    // ok let's make a vector of vector of void buffers, which holds the input/output
-    // vectors for each arch
     std::vector<std::vector<void*>> test_data;
-    for (size_t i = 0; i < arch_list.size(); i++) {
-        std::vector<void*> arch_buffs;
-        for (size_t j = 0; j < outputsig.size(); j++) {
-            arch_buffs.push_back(mem_pool.get_new(vlen * outputsig[j].size *
-                                                  (outputsig[j].is_complex ? 2 : 1)));
+    std::vector<std::vector<void*>> rotation_data;
+    try {
+        for (unsigned int inputsig_index = 0; inputsig_index < inputsig.size();
+             ++inputsig_index) {
+            volk_type_t sig = inputsig[inputsig_index];
+            if (!sig.is_scalar) // we don't make buffers for scalars
+                inbuffs.push_back(
+                    mem_pool.get_new(vlen * sig.size * (sig.is_complex ? 2 : 1)));
         }
-        for (size_t j = 0; j < inputsig.size(); j++) {
-            void* arch_inbuff = mem_pool.get_new(vlen * inputsig[j].size *
-                                                 (inputsig[j].is_complex ? 2 : 1));
-            memcpy(arch_inbuff,
-                   inbuffs[j],
-                   vlen * inputsig[j].size * (inputsig[j].is_complex ? 2 : 1));
-            arch_buffs.push_back(arch_inbuff);
+        for (size_t i = 0; i < inbuffs.size(); i++) {
+            load_random_data(inbuffs[i], inputsig[i], vlen, input);
+        }
+
+        // ok let's make a vector of vector of void buffers, which holds the input/output
+        // vectors for each arch
+        for (size_t i = 0; i < arch_list.size(); i++) {
+            std::vector<void*> arch_buffs;
+            for (size_t j = 0; j < outputsig.size(); j++) {
+                arch_buffs.push_back(mem_pool.get_new(vlen * outputsig[j].size *
+                                                      (outputsig[j].is_complex ? 2 : 1)));
+            }
+            for (size_t j = 0; j < inputsig.size(); j++) {
+                void* arch_inbuff = mem_pool.get_new(vlen * inputsig[j].size *
+                                                     (inputsig[j].is_complex ? 2 : 1));
+                memcpy(arch_inbuff,
+                       inbuffs[j],
+                       vlen * inputsig[j].size * (inputsig[j].is_complex ? 2 : 1));
+                arch_buffs.push_back(arch_inbuff);
+            }
+            test_data.push_back(arch_buffs);
         }
-        test_data.push_back(arch_buffs);
+
+        // more copies of the buffers, shared by all archs, which the timed calls
+        // rotate through so that their data is evicted from the caches again
+        for (unsigned int set = 1; set < buffer_sets; set++) {
+            std::vector<void*> set_buffs;
+            for (size_t j = 0; j < outputsig.size(); j++) {
+                set_buffs.push_back(mem_pool.get_new(vlen * outputsig[j].size *
+                                                     (outputsig[j].is_complex ? 2 : 1)));
+            }
+            for (size_t j = 0; j < inputsig.size(); j++) {
+                const size_t size =
+                    vlen * inputsig[j].size * (inputsig[j].is_complex ? 2 : 1);
+                set_buffs.push_back(mem_pool.get_new(size));
+                memcpy(set_buffs.back(), inbuffs[j], size);
+            }
+            rotation_data.push_back(set_buffs);
+        }
+    } catch (std::bad_alloc&) {
+        return true; // get_new said which buffer
     }
 
     std::vector<volk_type_t> both_sigs;
@@ -615,27 +1178,23 @@ bool run_volk_tests(volk_func_desc_t desc,
 
     // now run the test
     vlen = vlen - vlen_twiddle;
-    std::chrono::time_point<std::chrono::system_clock> start, end;
-    std::vector<double> profile_times;
-    for (size_t i = 0; i < arch_list.size(); i++) {
-        start = std::chrono::system_clock::now();
-
+    auto run_arch = [&](size_t i, std::vector<void*>& buffs, unsigned int iter) {
         switch (both_sigs.size()) {
         case 1:
             if (inputsc.size() == 0) {
                 run_cast_test1(
-                    (volk_fn_1arg)(manual_func), test_data[i], vlen, iter, arch_list[i]);
+                    (volk_fn_1arg)(manual_func), buffs, vlen, iter, arch_list[i]);
             } else if (inputsc.size() == 1 && inputsc[0].is_float) {
                 if (inputsc[0].is_complex) {
                     run_cast_test1_s32fc((volk_fn_1arg_s32fc)(manual_func),
-                                         test_data[i],
+                                         buffs,
                                          scalar,
                                          vlen,
                                          iter,
                                          arch_list[i]);
                 } else {
                     run_cast_test1_s32f((volk_fn_1arg_s32f)(manual_func),
-                                        test_data[i],
+                                        buffs,
                                         scalar.real(),
                                         vlen,
                                         iter,
@@ -647,18 +1206,18 @@ bool run_volk_tests(volk_func_desc_t desc,
         case 2:
             if (inputsc.size() == 0) {
                 run_cast_test2(
-                    (volk_fn_2arg)(manual_func), test_data[i], vlen, iter, arch_list[i]);
+                    (volk_fn_2arg)(manual_func), buffs, vlen, iter, arch_list[i]);
             } else if (inputsc.size() == 1 && inputsc[0].is_float) {
                 if (inputsc[0].is_complex) {
                     run_cast_test2_s32fc((volk_fn_2arg_s32fc)(manual_func),
-                                         test_data[i],
+                                         buffs,
                                          scalar,
                                          vlen,
                                          iter,
                                          arch_list[i]);
                 } else {
                     run_cast_test2_s32f((volk_fn_2arg_s32f)(manual_func),
-                                        test_data[i],
+                                        buffs,
                                         scalar.real(),
                                         vlen,
                                         iter,
@@ -670,18 +1229,18 @@ bool run_volk_tests(volk_func_desc_t desc,
         case 3:
             if (inputsc.size() == 0) {
                 run_cast_test3(
-                    (volk_fn_3arg)(manual_func), test_data[i], vlen, iter, arch_list[i]);
+                    (volk_fn_3arg)(manual_func), buffs, vlen, iter, arch_list[i]);
             } else if (inputsc.size() == 1 && inputsc[0].is_float) {
                 if (inputsc[0].is_complex) {
                     run_cast_test3_s32fc((volk_fn_3arg_s32fc)(manual_func),
-                                         test_data[i],
+                                         buffs,
                                          scalar,
                                          vlen,
                                          iter,
                                          arch_list[i]);
                 } else {
                     run_cast_test3_s32f((volk_fn_3arg_s32f)(manual_func),
-                                        test_data[i],
+                                        buffs,
                                         scalar.real(),
                                         vlen,
                                         iter,
@@ -692,25 +1251,187 @@ bool run_volk_tests(volk_func_desc_t desc,
             break;
         case 4:
             run_cast_test4(
-                (volk_fn_4arg)(manual_func), test_data[i], vlen, iter, arch_list[i]);
+                (volk_fn_4arg)(manual_func), buffs, vlen, iter, arch_list[i]);
             break;
         default:
             throw "no function handler for this signature";
             break;
         }
+    };
+
+    // time every call on its own, after untimed warm-up calls. Calls on short
+    // vectors are timed in batches so that reading the clock does not dominate.
+    volk_qa_cpu_pin cpu_pin(pin_cpu);
+    std::vector<std::unique_ptr<volk_qa_perf_counters>> counters(arch_list.size());
+    for (size_t i = 0; perf_counters && i < arch_list.size(); i++) {
+        counters[i].reset(new volk_qa_perf_counters());
+        if (!counters[i]->available()) {
+            counters.clear();
+            counters.resize(arch_list.size());
+            break;
+        }
+    }
+    const unsigned int batch = vlen < 1024 ? 1024 / std::max(vlen, 1u) : 1;
+    std::vector<std::vector<double>> samples(arch_list.size());
+
+    // run an arch on all threads at once, each on its own CPU and buffers
+    auto run_concurrently = [&](size_t i,
+                                std::vector<double>& all_samples,
+                                volk_test_time_t& result) {
+        const unsigned int n_cpus = std::max(std::thread::hardware_concurrency(), 1u);
+        const unsigned int calls = samples[i].size(); // as many as timed alone
+        std::vector<std::vector<double>> thread_samples(threads);
+        std::vector<double> thread_seconds(threads);
+        // a blocking barrier, so more threads than CPUs still make progress
+        std::mutex ready_mutex;
+        std::condition_variable ready_cv;
+        unsigned int ready = 0;
+        std::vector<std::thread> workers;
+        for (unsigned int t = 0; t < threads; t++) {
+            workers.emplace_back([&, t]() {
+                volk_qa_cpu_pin thread_pin((std::max(pin_cpu, 0) + t) % n_cpus);
+                volk_qa_aligned_mem_pool thread_pool(mem_node);
+                std::vector<void*> buffs;
+                bool allocated = true;
+                try {
+                    for (size_t j = 0; j < outputsig.size(); j++) {
+                        const size_t size = (vlen + vlen_twiddle) * outputsig[j].size *
+                                            (outputsig[j].is_complex ? 2 : 1);
+                        buffs.push_back(thread_pool.get_new(size));
+                    }
+                    for (size_t j = 0; j < inputsig.size(); j++) {
+                        const size_t size = (vlen + vlen_twiddle) * inputsig[j].size *
+                                            (inputsig[j].is_complex ? 2 : 1);
+                        buffs.push_back(thread_pool.get_new(size));
+                        memcpy(buffs.back(), inbuffs[j], size);
+                    }
+                    run_arch(i, buffs, warmup);
+                } catch (std::bad_alloc&) {
+                    allocated = false; // get_new said which buffer
+                }
+
+                {
+                    std::unique_lock<std::mutex> lock(ready_mutex);
+                    if (++ready == threads) {
+                        ready_cv.notify_all();
+                    } else {
+                        ready_cv.wait(lock, [&]() { return ready == threads; });
+                    }
+                }
+                if (!allocated) {
+                    return;
+                }
+                auto first = std::chrono::steady_clock::now();
+                thread_samples[t].reserve(calls);
+                for (unsigned int it = 0; it < calls; it++) {
+                    auto start = std::chrono::steady_clock::now();
+                    run_arch(i, buffs, batch);
+                    auto end = std::chrono::steady_clock::now();
+                    thread_samples[t].push_back(
+                        1000.0 * std::chrono::duration<double>(end - start).count() /
+                        batch);
+                }
+                auto last = std::chrono::steady_clock::now();
+                thread_seconds[t] = std::chrono::duration<double>(last - first).count();
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        const double points = (double)calls * batch * vlen;
+        double slowest = 0.0;
+        all_samples.clear();
+        result.thread_throughput.clear();
+        for (unsigned int t = 0; t < threads; t++) {
+            all_samples.insert(
+                all_samples.end(), thread_samples[t].begin(), thread_samples[t].end());
+            result.thread_throughput.push_back(
+                thread_seconds[t] > 0.0 ? points / (1e9 * thread_seconds[t]) : 0.0);
+            slowest = std::max(slowest, thread_seconds[t]);
+        }
+        result.aggregate_throughput =
+            slowest > 0.0 ? threads * points / (1e9 * slowest) : 0.0;
+    };
 
-        end = std::chrono::system_clock::now();
-        std::chrono::duration<double> elapsed_seconds = end - start;
-        double arch_time = 1000.0 * elapsed_seconds.count();
-        std::cout << arch_list[i] << " completed in " << arch_time << " ms" << std::endl;
+    std::vector<std::vector<double>> contended_samples(arch_list.size());
+    std::vector<double> medians;
+    std::vector<double> aggregate_costs; // ns per point of all threads together
+    std::vector<size_t> sets(arch_list.size(), 0);
+    auto time_calls = [&](size_t i, unsigned int calls) {
+        if (counters[i]) {
+            counters[i]->start();
+        }
+        for (unsigned int it = 0; it < calls; it++) {
+            auto start = std::chrono::steady_clock::now();
+            if (rotation_data.empty()) {
+                run_arch(i, test_data[i], batch);
+            } else {
+                for (unsigned int call = 0; call < batch; call++) {
+                    sets[i] = (sets[i] + 1) % (rotation_data.size() + 1);
+                    run_arch(i, sets[i] ? rotation_data[sets[i] - 1] : test_data[i], 1);
+                }
+            }
+            auto end = std::chrono::steady_clock::now();
+            samples[i].push_back(
+                1000.0 * std::chrono::duration<double>(end - start).count() / batch);
+        }
+        if (counters[i]) {
+            counters[i]->stop();
+        }
+    };
+
+    if (adaptive) {
+        for (size_t i = 0; i < arch_list.size(); i++) {
+            run_arch(i, test_data[i], warmup);
+        }
+        time_until_settled(desc, samples, iter, time_calls);
+    } else {
+        for (size_t i = 0; i < arch_list.size(); i++) {
+            run_arch(i, test_data[i], warmup);
+            samples[i].reserve(iter);
+            time_calls(i, iter);
+        }
+    }
+
+    for (size_t i = 0; i < arch_list.size(); i++) {
         volk_test_time_t result;
         result.name = arch_list[i];
-        result.time = arch_time;
         result.units = "ms";
         result.pass = true;
+        summarize_samples(samples[i], result);
+        std::cout << arch_list[i] << " completed in " << result.time
+                  << " ms (median " << result.median << ", p90 " << result.p90
+                  << ", p99 " << result.p99 << ", cv " << result.cv << ", "
+                  << result.samples << " samples)" << std::endl;
+        if (counters[i]) {
+            read_counters(*counters[i], (double)result.samples * batch, result);
+            std::cout << "  per call: " << result.cycles << " cycles, "
+                      << result.instructions << " instructions, IPC " << result.ipc
+                      << ", " << result.l1d_misses << " L1D misses, "
+                      << result.llc_misses << " LLC misses, " << result.ghz << " GHz"
+                      << std::endl;
+        }
+        if (threads > 1) {
+            run_concurrently(i, contended_samples[i], result);
+            const auto range = std::minmax_element(result.thread_throughput.begin(),
+                                                   result.thread_throughput.end());
+            std::cout << "  on " << threads << " threads: " << result.aggregate_throughput
+                      << " points/ns together, " << *range.first << " to "
+                      << *range.second << " per thread" << std::endl;
+            aggregate_costs.push_back(result.aggregate_throughput > 0.0
+                                          ? 1.0 / result.aggregate_throughput
+                                          : std::numeric_limits<double>::max());
+        }
         results->back().results[result.name] = result;
 
-        profile_times.push_back(arch_time);
+        medians.push_back(result.median);
+    }
+    if (rank_aggregate && threads > 1) {
+        // the best aggregate throughput wins, ties are judged on the call
+        // times measured while all threads ran
+        samples.swap(contended_samples);
+        medians.swap(aggregate_costs);
     }
 
     // and now compare each output to the generic output
@@ -729,6 +1450,8 @@ bool run_volk_tests(volk_func_desc_t desc,
     std::vector<bool> arch_results;
     for (size_t i = 0; i < arch_list.size(); i++) {
         fail = false;
+        // padded twins may write anything past the points they were called with
+        const unsigned int check_len = i < desc.n_impls ? vlen : vlen - vlen_twiddle;
         if (i != generic_offset) {
             for (size_t j = 0; j < both_sigs.size(); j++) {
                 if (both_sigs[j].is_float) {
@@ -736,13 +1459,13 @@ bool run_volk_tests(volk_func_desc_t desc,
                         if (both_sigs[j].is_complex) {
                             fail = ccompare((double*)test_data[generic_offset][j],
                                             (double*)test_data[i][j],
-                                            vlen,
+                                            check_len,
                                             tol_f,
                                             absolute_mode);
                         } else {
                             fail = fcompare((double*)test_data[generic_offset][j],
                                             (double*)test_data[i][j],
-                                            vlen,
+                                            check_len,
                                             tol_f,
                                             absolute_mode);
                         }
@@ -750,13 +1473,13 @@ bool run_volk_tests(volk_func_desc_t desc,
                         if (both_sigs[j].is_complex) {
                             fail = ccompare((float*)test_data[generic_offset][j],
                                             (float*)test_data[i][j],
-                                            vlen,
+                                            check_len,
                                             tol_f,
                                             absolute_mode);
                         } else {
                             fail = fcompare((float*)test_data[generic_offset][j],
                                             (float*)test_data[i][j],
-                                            vlen,
+                                            check_len,
                                             tol_f,
                                             absolute_mode);
                         }
@@ -769,13 +1492,13 @@ bool run_volk_tests(volk_func_desc_t desc,
                         if (both_sigs[j].is_signed) {
                             fail = icompare((int64_t*)test_data[generic_offset][j],
                                             (int64_t*)test_data[i][j],
-                                            vlen * (both_sigs[j].is_complex ? 2 : 1),
+                                            check_len * (both_sigs[j].is_complex ? 2 : 1),
                                             tol_i,
                                             absolute_mode);
                         } else {
                             fail = icompare((uint64_t*)test_data[generic_offset][j],
                                             (uint64_t*)test_data[i][j],
-                                            vlen * (both_sigs[j].is_complex ? 2 : 1),
+                                            check_len * (both_sigs[j].is_complex ? 2 : 1),
                                             tol_i,
                                             absolute_mode);
                         }
@@ -783,31 +1506,35 @@ bool run_volk_tests(volk_func_desc_t desc,
                     case 4:
                         if (both_sigs[j].is_complex) {
                             if (both_sigs[j].is_signed) {
-                                fail = icompare((int16_t*)test_data[generic_offset][j],
-                                                (int16_t*)test_data[i][j],
-                                                vlen * (both_sigs[j].is_complex ? 2 : 1),
-                                                tol_i,
-                                                absolute_mode);
+                                fail = icompare(
+                                    (int16_t*)test_data[generic_offset][j],
+                                    (int16_t*)test_data[i][j],
+                                    check_len * (both_sigs[j].is_complex ? 2 : 1),
+                                    tol_i,
+                                    absolute_mode);
                             } else {
-                                fail = icompare((uint16_t*)test_data[generic_offset][j],
-                                                (uint16_t*)test_data[i][j],
-                                                vlen * (both_sigs[j].is_complex ? 2 : 1),
-                                                tol_i,
-                                                absolute_mode);
+                                fail = icompare(
+                                    (uint16_t*)test_data[generic_offset][j],
+                                    (uint16_t*)test_data[i][j],
+                                    check_len * (both_sigs[j].is_complex ? 2 : 1),
+                                    tol_i,
+                                    absolute_mode);
                             }
                         } else {
                             if (both_sigs[j].is_signed) {
-                                fail = icompare((int32_t*)test_data[generic_offset][j],
-                                                (int32_t*)test_data[i][j],
-                                                vlen * (both_sigs[j].is_complex ? 2 : 1),
-                                                tol_i,
-                                                absolute_mode);
+                                fail = icompare(
+                                    (int32_t*)test_data[generic_offset][j],
+                                    (int32_t*)test_data[i][j],
+                                    check_len * (both_sigs[j].is_complex ? 2 : 1),
+                                    tol_i,
+                                    absolute_mode);
                             } else {
-                                fail = icompare((uint32_t*)test_data[generic_offset][j],
-                                                (uint32_t*)test_data[i][j],
-                                                vlen * (both_sigs[j].is_complex ? 2 : 1),
-                                                tol_i,
-                                                absolute_mode);
+                                fail = icompare(
+                                    (uint32_t*)test_data[generic_offset][j],
+                                    (uint32_t*)test_data[i][j],
+                                    check_len * (both_sigs[j].is_complex ? 2 : 1),
+                                    tol_i,
+                                    absolute_mode);
                             }
                         }
                         break;
@@ -815,13 +1542,13 @@ bool run_volk_tests(volk_func_desc_t desc,
                         if (both_sigs[j].is_signed) {
                             fail = icompare((int16_t*)test_data[generic_offset][j],
                                             (int16_t*)test_data[i][j],
-                                            vlen * (both_sigs[j].is_complex ? 2 : 1),
+                                            check_len * (both_sigs[j].is_complex ? 2 : 1),
                                             tol_i,
                                             absolute_mode);
                         } else {
                             fail = icompare((uint16_t*)test_data[generic_offset][j],
                                             (uint16_t*)test_data[i][j],
-                                            vlen * (both_sigs[j].is_complex ? 2 : 1),
+                                            check_len * (both_sigs[j].is_complex ? 2 : 1),
                                             tol_i,
                                             absolute_mode);
                         }
@@ -830,13 +1557,13 @@ bool run_volk_tests(volk_func_desc_t desc,
                         if (both_sigs[j].is_signed) {
                             fail = icompare((int8_t*)test_data[generic_offset][j],
                                             (int8_t*)test_data[i][j],
-                                            vlen * (both_sigs[j].is_complex ? 2 : 1),
+                                            check_len * (both_sigs[j].is_complex ? 2 : 1),
                                             tol_i,
                                             absolute_mode);
                         } else {
                             fail = icompare((uint8_t*)test_data[generic_offset][j],
                                             (uint8_t*)test_data[i][j],
-                                            vlen * (both_sigs[j].is_complex ? 2 : 1),
+                                            check_len * (both_sigs[j].is_complex ? 2 : 1),
                                             tol_i,
                                             absolute_mode);
                         }
@@ -856,24 +1583,46 @@ bool run_volk_tests(volk_func_desc_t desc,
         arch_results.push_back(!fail);
     }
 
-    double best_time_a = std::numeric_limits<double>::max();
-    double best_time_u = std::numeric_limits<double>::max();
+    std::vector<size_t> candidates_a, candidates_u;
+    for (size_t i = 0; i < desc.n_impls; i++) {
+        if (arch_results[i]) {
+            candidates_a.push_back(i);
+            if (desc.impl_alignment[i] == 0) {
+                candidates_u.push_back(i);
+            }
+        }
+    }
     std::string best_arch_a = "generic";
     std::string best_arch_u = "generic";
-    for (size_t i = 0; i < arch_list.size(); i++) {
-        if ((profile_times[i] < best_time_u) && arch_results[i] &&
-            desc.impl_alignment[i] == 0) {
-            best_time_u = profile_times[i];
-            best_arch_u = arch_list[i];
-        }
-        if ((profile_times[i] < best_time_a) && arch_results[i]) {
-            best_time_a = profile_times[i];
-            best_arch_a = arch_list[i];
-        }
+    std::vector<size_t> tied_a, tied_u;
+    if (!candidates_a.empty()) {
+        size_t best = pick_best_arch(candidates_a, samples, medians, desc, tied_a);
+        best_arch_a = arch_list[best];
+    }
+    if (!candidates_u.empty()) {
+        size_t best = pick_best_arch(candidates_u, samples, medians, desc, tied_u);
+        best_arch_u = arch_list[best];
     }
+    results->back().significant_a = tied_a.size() == 1;
+    results->back().significant_u = tied_u.size() == 1;
 
-    std::cout << "Best aligned arch: " << best_arch_a << std::endl;
-    std::cout << "Best unaligned arch: " << best_arch_u << std::endl;
+    auto print_best = [&](const std::string& best, const std::vector<size_t>& tied) {
+        std::cout << best;
+        if (tied.size() > 1) {
+            std::cout << " (not significantly faster than";
+            for (size_t arch : tied) {
+                if (arch_list[arch] != best) {
+                    std::cout << " " << arch_list[arch];
+                }
+            }
+            std::cout << ")";
+        }
+        std::cout << std::endl;
+    };
+    std::cout << "Best aligned arch: ";
+    print_best(best_arch_a, tied_a);
+    std::cout << "Best unaligned arch: ";
+    print_best(best_arch_u, tied_u);
 
     if (puppet_master_name == "NULL") {
         results->back().config_name = name;
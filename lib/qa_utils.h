@@ -31,6 +31,18 @@ struct volk_type_t {
     std::string str;
 };
 
+// distributions load_random_data fills test inputs with
+enum volk_test_input_t {
+    VOLK_TEST_INPUT_UNIFORM,  // uniform, the default
+    VOLK_TEST_INPUT_GAUSSIAN, // zero mean noise with a standard deviation of 1/3
+    VOLK_TEST_INPUT_QPSK,     // unit power QPSK symbols
+    VOLK_TEST_INPUT_QAM16,    // unit power 16-QAM symbols
+    VOLK_TEST_INPUT_TONE,     // a unit amplitude tone with a random phase
+    VOLK_TEST_INPUT_SORTED,   // ascending from -1 to 1
+    VOLK_TEST_INPUT_DENORMAL, // subnormal floats, integers of magnitude 1 at most
+    VOLK_TEST_INPUT_EDGE,     // zeros, extremes, infinities and NaNs at random
+};
+
 class volk_test_time_t
 {
 public:
@@ -38,6 +50,55 @@ public:
     double time;
     std::string units;
     bool pass;
+    // statistics of the timed calls, one call per sample, in units
+    unsigned int samples = 0;
+    double median = 0.0;
+    double p90 = 0.0;
+    double p99 = 0.0;
+    double cv = 0.0; // coefficient of variation, stddev / mean
+    // hardware counters per call when collected, -1 where not counted
+    bool has_counters = false;
+    double cycles = -1.0;
+    double instructions = -1.0;
+    double ipc = -1.0;
+    double l1d_misses = -1.0;
+    double llc_misses = -1.0;
+    double ghz = -1.0; // effective clock frequency while running
+    // points per ns of all threads together and of each, for threaded runs
+    double aggregate_throughput = 0.0;
+    std::vector<double> thread_throughput;
+};
+
+class volk_test_length_bucket_t
+{
+public:
+    unsigned int min_points;
+    std::string best_arch_a;
+    std::string best_arch_u;
+};
+
+class volk_test_sweep_point_t
+{
+public:
+    unsigned int vlen;
+    unsigned int iter;
+    std::string best_arch_a;
+    std::string best_arch_u;
+    // elements per ns of each arch, from its median call time
+    std::map<std::string, double> throughput;
+};
+
+class volk_test_memory_level_t
+{
+public:
+    std::string level;
+    unsigned int vlen;
+    unsigned int buffer_sets;
+    std::string best_arch_a;
+    std::string best_arch_u;
+    // of each arch, from its median call time
+    std::map<std::string, double> gb_per_s;
+    std::map<std::string, double> elements_per_cycle;
 };
 
 class volk_test_results_t
@@ -50,6 +111,35 @@ public:
     std::map<std::string, volk_test_time_t> results;
     std::string best_arch_a;
     std::string best_arch_u;
+    // false when the best arch was not significantly faster than the others
+    bool significant_a = false;
+    bool significant_u = false;
+    unsigned int warmup = 0;
+    int pin_cpu = -1;
+    unsigned int threads = 1;
+    bool rank_aggregate = false;
+    // true when each arch was timed only until the ranking was settled
+    bool adaptive = false;
+    // name of the distribution the inputs were drawn from
+    std::string input = "uniform";
+    // best implementations for longer vectors, ascending min_points
+    std::vector<volk_test_length_bucket_t> length_buckets;
+    // one point per vector length of a --vlen-sweep, ascending vlen
+    std::vector<volk_test_sweep_point_t> sweep;
+    // one entry per level of a --memory-levels run
+    std::vector<volk_test_memory_level_t> memory_levels;
+    // per arch, call time on denormal inputs over that on the usual ones,
+    // without and with flushing denormals, from a --denormal-penalty run
+    std::map<std::string, double> denormal_penalty;
+    std::map<std::string, double> flushed_penalty;
+    // NUMA node the buffers were placed on, -1 for wherever malloc put them
+    int mem_node = -1;
+    // per arch GB/s with the buffers on the node of the timing thread and
+    // on another node, from a --numa run
+    int local_node = -1;
+    int remote_node = -1;
+    std::map<std::string, double> local_gb_per_s;
+    std::map<std::string, double> remote_gb_per_s;
 };
 
 class volk_test_params_t
@@ -59,6 +149,15 @@ private:
     lv_32fc_t _scalar;
     unsigned int _vlen;
     unsigned int _iter;
+    unsigned int _warmup;
+    int _pin_cpu;
+    unsigned int _buffer_sets;
+    bool _perf_counters;
+    unsigned int _threads;
+    bool _rank_aggregate;
+    bool _adaptive;
+    volk_test_input_t _input;
+    int _mem_node;
     bool _benchmark_mode;
     bool _absolute_mode;
     std::string _kernel_regex;
@@ -75,6 +174,15 @@ public:
           _scalar(scalar),
           _vlen(vlen),
           _iter(iter),
+          _warmup(1),
+          _pin_cpu(-1),
+          _buffer_sets(1),
+          _perf_counters(false),
+          _threads(1),
+          _rank_aggregate(false),
+          _adaptive(false),
+          _input(VOLK_TEST_INPUT_UNIFORM),
+          _mem_node(-1),
           _benchmark_mode(benchmark_mode),
           _absolute_mode(false),
           _kernel_regex(kernel_regex){};
@@ -83,6 +191,15 @@ public:
     void set_scalar(lv_32fc_t scalar) { _scalar = scalar; };
     void set_vlen(unsigned int vlen) { _vlen = vlen; };
     void set_iter(unsigned int iter) { _iter = iter; };
+    void set_warmup(unsigned int warmup) { _warmup = warmup; };
+    void set_pin_cpu(int cpu) { _pin_cpu = cpu; };
+    void set_buffer_sets(unsigned int sets) { _buffer_sets = sets; };
+    void set_perf_counters(bool perf_counters) { _perf_counters = perf_counters; };
+    void set_threads(unsigned int threads) { _threads = threads; };
+    void set_rank_aggregate(bool rank_aggregate) { _rank_aggregate = rank_aggregate; };
+    void set_adaptive(bool adaptive) { _adaptive = adaptive; };
+    void set_input(volk_test_input_t input) { _input = input; };
+    void set_mem_node(int node) { _mem_node = node; };
     void set_benchmark(bool benchmark) { _benchmark_mode = benchmark; };
     void set_regex(std::string regex) { _kernel_regex = regex; };
     // getters
@@ -90,6 +207,15 @@ public:
     lv_32fc_t scalar() { return _scalar; };
     unsigned int vlen() { return _vlen; };
     unsigned int iter() { return _iter; };
+    unsigned int warmup() { return _warmup; };
+    int pin_cpu() { return _pin_cpu; };
+    unsigned int buffer_sets() { return _buffer_sets; };
+    bool perf_counters() { return _perf_counters; };
+    unsigned int threads() { return _threads; };
+    bool rank_aggregate() { return _rank_aggregate; };
+    bool adaptive() { return _adaptive; };
+    volk_test_input_t input() { return _input; };
+    int mem_node() { return _mem_node; };
     bool benchmark_mode() { return _benchmark_mode; };
     bool absolute_mode() { return _absolute_mode; };
     std::string kernel_regex() { return _kernel_regex; };
@@ -153,6 +279,17 @@ volk_type_t volk_type_from_string(std::string);
 
 float uniform(void);
 void random_floats(float* buf, unsigned n);
+void load_random_data(void* data,
+                      volk_type_t type,
+                      unsigned int n,
+                      volk_test_input_t input = VOLK_TEST_INPUT_UNIFORM);
+// false for an unknown name, which leaves input untouched
+bool volk_test_input_from_string(const std::string& name, volk_test_input_t& input);
+std::string volk_test_input_name(volk_test_input_t input);
+// the names volk_test_input_from_string accepts, comma separated
+std::string volk_test_input_names(void);
+// bytes of all vector inputs and outputs per point, from the kernel name
+size_t volk_test_bytes_per_point(std::string name);
 
 bool run_volk_tests(volk_func_desc_t,
                     void (*)(),
@@ -0,0 +1,152 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of VOLK
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include <stdlib.h>           // for mkdtemp
+#include <volk/volk.h>        // for volk_32f_x2_add_32f, volk_get_cpu_fingerprint, ...
+#include <volk/volk_alloc.hh> // for vector
+#include <cstdio>             // for sscanf
+#include <cstring>            // for strcmp, strlen
+#include <filesystem>         // for path, create_directories, remove_all, temp_dir...
+#include <fstream>            // for ifstream, ofstream
+#include <map>                // for map
+#include <string>             // for string, getline
+#include <vector>             // for vector
+
+#include "unit_test.h" // for UNIT_CHECK, unit_test_result, unit_test_run_child
+
+namespace fs = std::filesystem;
+
+static const char* const add_kernel = "volk_32f_x2_add_32f";
+static const char* const multiply_kernel = "volk_32f_x2_multiply_32f";
+
+// the child: enough aligned calls of one length to tune that bucket
+static int run_child()
+{
+    const unsigned int num_points = 1000;
+    volk::vector<float> a(num_points), b(num_points), c(num_points);
+    for (unsigned int i = 0; i < num_points; i++) {
+        a[i] = (float)i;
+        b[i] = 0.5f * (float)i;
+    }
+    for (unsigned int call = 0; call < 256; call++) {
+        volk_32f_x2_add_32f(c.data(), a.data(), b.data(), num_points);
+        for (unsigned int i = 0; i < num_points; i++) {
+            if (c[i] != 1.5f * (float)i) {
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+// the lines of each section of a config, "" holds the lines before the first
+static std::map<std::string, std::vector<std::string>> read_sections(const fs::path& path)
+{
+    std::map<std::string, std::vector<std::string>> sections;
+    std::ifstream in(path);
+    std::string section, line;
+    while (std::getline(in, line)) {
+        if (line.size() > 1 && line.front() == '[' && line.back() == ']') {
+            section = line.substr(1, line.size() - 2);
+        } else if (!line.empty()) {
+            sections[section].push_back(line);
+        }
+    }
+    return sections;
+}
+
+// does the config line name two implementations of the add kernel?
+static bool valid_add_line(const std::string& line)
+{
+    char name[128], impl_a[128], impl_u[128];
+    if (sscanf(line.c_str(), "%127s %127s %127s", name, impl_a, impl_u) != 3 ||
+        strcmp(name, add_kernel) != 0) {
+        return false;
+    }
+    const volk_func_desc_t desc = volk_32f_x2_add_32f_get_func_desc();
+    bool found_a = false, found_u = false;
+    for (size_t i = 0; i < desc.n_impls; i++) {
+        found_a |= strcmp(desc.impl_names[i], impl_a) == 0;
+        found_u |= strcmp(desc.impl_names[i], impl_u) == 0;
+    }
+    return found_a && found_u;
+}
+
+/*
+ * VOLK_ADAPTIVE=write replaces the host's line of the tuned kernel and
+ * keeps every other line. Libraries built without ENABLE_ADAPTIVE_DISPATCH
+ * leave the config as it is, which passes as well.
+ */
+static void test_save(const char* self, const fs::path& dir)
+{
+    const std::string fingerprint = volk_get_cpu_fingerprint();
+    const std::string add_line = std::string(add_kernel) + " generic generic";
+    const std::string multiply_line = std::string(multiply_kernel) + " generic generic";
+    const fs::path config = dir / "volk" / "volk_config";
+    fs::create_directories(config.parent_path());
+    {
+        std::ofstream out(config);
+        out << add_line << "\n";
+        out << "[" << fingerprint << "]\n";
+        out << add_line << "\n";
+        out << multiply_line << "\n";
+        out << "[another-host]\n";
+        out << add_line << "\n";
+    }
+
+    const int tuned = unit_test_run_child(self,
+                                          "tune",
+                                          { { "VOLK_CONFIGPATH", dir.string() },
+                                            { "VOLK_ADAPTIVE", "write" },
+                                            { "VOLK_ADAPTIVE_TRIALS", "1" } });
+    UNIT_CHECK(tuned == 0);
+
+    auto sections = read_sections(config);
+    UNIT_CHECK(sections[""] == std::vector<std::string>{ add_line });
+    UNIT_CHECK(sections["another-host"] == std::vector<std::string>{ add_line });
+    const std::vector<std::string>& host = sections[fingerprint];
+    UNIT_CHECK(host.size() == 2);
+    // the kernel that was never called keeps its line
+    size_t n_add = 0, n_multiply = 0;
+    for (const std::string& line : host) {
+        if (line.compare(0, strlen(add_kernel) + 1, std::string(add_kernel) + " ") == 0) {
+            UNIT_CHECK(valid_add_line(line));
+            n_add++;
+        } else {
+            UNIT_CHECK(line == multiply_line);
+            n_multiply++;
+        }
+    }
+    UNIT_CHECK(n_add == 1);
+    UNIT_CHECK(n_multiply == 1);
+
+    // the saved config loads again
+    const int reloaded = unit_test_run_child(
+        self, "reload", { { "VOLK_CONFIGPATH", dir.string() }, { "VOLK_ADAPTIVE", "" } });
+    UNIT_CHECK(reloaded == 0);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc > 1 && strcmp(argv[1], "--child") == 0) {
+        return run_child();
+    }
+
+    std::string dir_template =
+        (fs::temp_directory_path() / "volk_test_adaptive.XXXXXX").string();
+    if (!mkdtemp(&dir_template[0])) {
+        std::cerr << "cannot create a temporary directory" << std::endl;
+        return 1;
+    }
+    const fs::path dir = dir_template;
+    test_save(argv[0], dir);
+    fs::remove_all(dir);
+
+    return unit_test_result("volk_adaptive");
+}
@@ -0,0 +1,162 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of VOLK
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include <unistd.h>            // for sysconf
+#include <volk/volk_circbuf.h> // for volk_circbuf_create, volk_circbuf_size, ...
+#include <cstring>             // for memcmp, memset
+#include <thread>              // for thread, yield
+
+#include "unit_test.h" // for UNIT_CHECK, unit_test_result
+
+static size_t page_size()
+{
+    const long page = sysconf(_SC_PAGESIZE);
+    return page > 0 ? (size_t)page : 4096;
+}
+
+// a window across the end of the buffer is contiguous and the second
+// mapping shows the same bytes as the first
+static void test_wrap()
+{
+    volk_circbuf_t* buf = volk_circbuf_create(page_size(), 1);
+    UNIT_CHECK(buf != NULL);
+    if (!buf) {
+        return;
+    }
+    const size_t size = volk_circbuf_size(buf);
+    UNIT_CHECK(size == page_size());
+
+    size_t writable = 0, readable = 0;
+    char* base = (char*)volk_circbuf_write_ptr(buf, &writable);
+    UNIT_CHECK(writable == size);
+    UNIT_CHECK(volk_circbuf_read_ptr(buf, &readable) == base);
+    UNIT_CHECK(readable == 0);
+
+    // move both positions to 100 bytes before the end
+    const size_t lead = size - 100;
+    memset(base, 0, lead);
+    volk_circbuf_produce(buf, lead);
+    volk_circbuf_consume(buf, lead);
+
+    char* window = (char*)volk_circbuf_write_ptr(buf, &writable);
+    UNIT_CHECK(window == base + lead);
+    UNIT_CHECK(writable == size);
+    for (size_t i = 0; i < 300; i++) {
+        window[i] = (char)(i * 7 + 1);
+    }
+    volk_circbuf_produce(buf, 300);
+
+    const char* read = (const char*)volk_circbuf_read_ptr(buf, &readable);
+    UNIT_CHECK(read == window);
+    UNIT_CHECK(readable == 300);
+    // the 200 bytes past the end landed at the start of the first mapping
+    UNIT_CHECK(memcmp(base, window + 100, 200) == 0);
+    for (size_t i = 0; i < size; i++) {
+        if (base[i] != base[i + size]) {
+            UNIT_CHECK(base[i] == base[i + size]);
+            break;
+        }
+    }
+    volk_circbuf_consume(buf, 300);
+
+    // the positions continue from the start of the buffer
+    UNIT_CHECK(volk_circbuf_write_ptr(buf, &writable) == base + 200);
+    UNIT_CHECK(writable == size);
+    UNIT_CHECK(volk_circbuf_read_ptr(buf, &readable) == base + 200);
+    UNIT_CHECK(readable == 0);
+
+    // a full buffer is not mistaken for an empty one
+    volk_circbuf_produce(buf, size);
+    volk_circbuf_write_ptr(buf, &writable);
+    volk_circbuf_read_ptr(buf, &readable);
+    UNIT_CHECK(writable == 0);
+    UNIT_CHECK(readable == size);
+    volk_circbuf_destroy(buf);
+}
+
+// sizes are rounded up to pages that whole items fill, bad sizes fail
+static void test_sizes()
+{
+    const size_t page = page_size();
+    const size_t requests[][2] = {
+        { 1, 1 }, { 1000, 1 }, { page + 1, 1 }, { 5000, 12 }, { 3 * page, 8 }
+    };
+    for (const auto& request : requests) {
+        volk_circbuf_t* buf = volk_circbuf_create(request[0], request[1]);
+        UNIT_CHECK(buf != NULL);
+        if (!buf) {
+            continue;
+        }
+        const size_t size = volk_circbuf_size(buf);
+        UNIT_CHECK(size >= request[0]);
+        UNIT_CHECK(size % page == 0);
+        UNIT_CHECK(size % request[1] == 0);
+        UNIT_CHECK(size < request[0] + page * request[1]);
+        volk_circbuf_destroy(buf);
+    }
+    UNIT_CHECK(volk_circbuf_create(0, 1) == NULL);
+    UNIT_CHECK(volk_circbuf_create(page, 0) == NULL);
+    volk_circbuf_destroy(NULL); // ignored
+}
+
+// one thread writes a running count that another one reads back
+static void test_threads()
+{
+    volk_circbuf_t* buf = volk_circbuf_create(page_size(), sizeof(unsigned int));
+    UNIT_CHECK(buf != NULL);
+    if (!buf) {
+        return;
+    }
+    const unsigned int total = 1u << 18;
+    std::thread writer([buf, total]() {
+        unsigned int next = 0;
+        while (next < total) {
+            size_t writable;
+            unsigned int* out = (unsigned int*)volk_circbuf_write_ptr(buf, &writable);
+            size_t n = writable / sizeof(unsigned int);
+            n = n < total - next ? n : total - next;
+            if (!n) {
+                std::this_thread::yield();
+            }
+            for (size_t i = 0; i < n; i++) {
+                out[i] = next++;
+            }
+            volk_circbuf_produce(buf, n * sizeof(unsigned int));
+        }
+    });
+    unsigned int received = 0;
+    bool in_order = true;
+    while (received < total) {
+        size_t readable;
+        const unsigned int* in =
+            (const unsigned int*)volk_circbuf_read_ptr(buf, &readable);
+        const size_t n = readable / sizeof(unsigned int);
+        if (!n) {
+            std::this_thread::yield();
+        }
+        for (size_t i = 0; i < n; i++) {
+            if (in[i] != received++) {
+                in_order = false;
+            }
+        }
+        volk_circbuf_consume(buf, n * sizeof(unsigned int));
+    }
+    UNIT_CHECK(in_order);
+    writer.join();
+    volk_circbuf_destroy(buf);
+}
+
+int main()
+{
+    test_wrap();
+    test_sizes();
+    test_threads();
+
+    return unit_test_result("volk_circbuf");
+}
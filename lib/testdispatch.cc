@@ -0,0 +1,232 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of VOLK
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include <stdlib.h>           // for mkdtemp
+#include <volk/volk.h>        // for volk_32f_x2_add_32f, volk_set_impl, ...
+#include <volk/volk_alloc.hh> // for vector
+#include <algorithm>          // for fill
+#include <cstring>            // for strcmp, strstr
+#include <filesystem>         // for path, create_directories, remove_all, temp_dir...
+#include <fstream>            // for ofstream
+#include <string>             // for string, operator+
+#include <utility>            // for pair
+#include <vector>             // for vector
+
+#include "unit_test.h" // for UNIT_CHECK, unit_test_result, unit_test_run_child
+
+/*
+ * The dispatcher as applications call it: misaligned buffers, length
+ * buckets from volk_config, volk_set_impl and VOLK_IMPL_<kernel>. The
+ * tests that depend on volk_config or the environment run in a child
+ * process, as VOLK reads both once, or even while loading with
+ * ENABLE_EAGER_DISPATCH.
+ */
+
+namespace fs = std::filesystem;
+
+static const char* const accumulator = "volk_32f_accumulator_s32f";
+
+/*
+ * The implementation volk_32f_accumulator_s32f runs is visible in its
+ * result: summing 2^27 and then ones one at a time, as the generic
+ * implementation does, rounds every one away. SIMD implementations sum
+ * the ones in separate lanes first.
+ */
+static const float big = 134217728.0f;
+
+static bool accumulator_is_generic(unsigned int num_points, bool aligned)
+{
+    volk::vector<float> input(num_points + 1, 1.0f);
+    volk::vector<float> result(1);
+    float* in = input.data() + (aligned ? 0 : 1);
+    in[0] = big;
+    volk_32f_accumulator_s32f(result.data(), in, num_points);
+    return result[0] == big;
+}
+
+// SIMD implementations of the accumulator, empty names if there are none
+static void accumulator_impls(std::string& aligned_only, std::string& unaligned)
+{
+    const volk_func_desc_t desc = volk_32f_accumulator_s32f_get_func_desc();
+    for (size_t i = 0; i < desc.n_impls; i++) {
+        if (strstr(desc.impl_names[i], "generic")) {
+            continue;
+        }
+        std::string& name = desc.impl_alignment[i] ? aligned_only : unaligned;
+        if (name.empty()) {
+            name = desc.impl_names[i];
+        }
+    }
+}
+
+// element-wise kernels at every offset up to 16 elements, with peeling
+// where the library is built with ENABLE_PEEL_DISPATCH
+static int child_peel()
+{
+    const unsigned int max_points = 300, max_offset = 16;
+    const size_t size = max_points + 2 * max_offset;
+    volk::vector<float> a(size), b(size), c(size);
+    volk::vector<double> b64(size), c64(size);
+    for (size_t i = 0; i < size; i++) {
+        a[i] = 0.5f * (float)i;
+        b[i] = 1000.0f - (float)i;
+        b64[i] = 2000.0 - (double)i;
+    }
+
+    for (unsigned int offset = 0; offset < max_offset; offset++) {
+        // all buffers misaligned alike, then the output one element further
+        for (unsigned int shift = 0; shift < 2; shift++) {
+            const unsigned int out = offset + shift;
+            for (unsigned int num_points = 0; num_points < max_points; num_points++) {
+                std::fill(c.begin(), c.end(), -1.0f);
+                std::fill(c64.begin(), c64.end(), -1.0);
+                volk_32f_x2_add_32f(
+                    c.data() + out, a.data() + offset, b.data() + offset, num_points);
+                volk_32f_64f_add_64f(
+                    c64.data() + out, a.data() + offset, b64.data() + offset, num_points);
+                bool ok = true;
+                for (size_t i = 0; i < size; i++) {
+                    const bool written = i >= out && i < out + num_points;
+                    const size_t in = i - out + offset;
+                    ok &= c[i] == (written ? a[in] + b[in] : -1.0f);
+                    ok &= c64[i] == (written ? (double)a[in] + b64[in] : -1.0);
+                }
+                if (!ok) {
+                    std::cerr << "offset " << offset << ", output offset " << out
+                              << ", " << num_points << " points" << std::endl;
+                }
+                UNIT_CHECK(ok);
+            }
+        }
+    }
+    return unit_test_result("dispatcher peel");
+}
+
+// volk_config: "<accumulator> generic generic 1024 <aligned_only> <unaligned>"
+static int child_buckets()
+{
+    std::string aligned_only, unaligned;
+    accumulator_impls(aligned_only, unaligned);
+
+    UNIT_CHECK(accumulator_is_generic(256, true));
+    UNIT_CHECK(accumulator_is_generic(256, false));
+    UNIT_CHECK(!accumulator_is_generic(2048, true));
+    UNIT_CHECK(!accumulator_is_generic(2048, false));
+
+    // an override applies to every length, also after volk_init_dispatch
+    UNIT_CHECK(volk_set_impl(accumulator, "generic", NULL));
+    volk_init_dispatch();
+    UNIT_CHECK(accumulator_is_generic(2048, true));
+    UNIT_CHECK(accumulator_is_generic(2048, false));
+
+    // until it is lifted again
+    UNIT_CHECK(volk_set_impl(accumulator, NULL, NULL));
+    UNIT_CHECK(accumulator_is_generic(256, true));
+    UNIT_CHECK(!accumulator_is_generic(2048, true));
+    UNIT_CHECK(!accumulator_is_generic(2048, false));
+    return unit_test_result("dispatcher length bucket");
+}
+
+/*
+ * volk_config: "<accumulator> generic generic", and the aligned only
+ * SIMD implementation in VOLK_IMPL_<accumulator>. volk_set_impl with that
+ * one name must do the same as the environment.
+ */
+static int child_override()
+{
+    std::string aligned_only, unaligned;
+    accumulator_impls(aligned_only, unaligned);
+    const char* impl = aligned_only.c_str();
+
+    UNIT_CHECK(!accumulator_is_generic(2048, true));
+    UNIT_CHECK(accumulator_is_generic(2048, false));
+
+    UNIT_CHECK(volk_set_impl(accumulator, "generic", "generic"));
+    UNIT_CHECK(accumulator_is_generic(2048, true));
+    UNIT_CHECK(volk_set_impl(accumulator, impl, NULL));
+    UNIT_CHECK(!accumulator_is_generic(2048, true));
+    UNIT_CHECK(accumulator_is_generic(2048, false));
+
+    // failures keep the kernel as it is
+    UNIT_CHECK(!volk_set_impl(accumulator, impl, impl));
+    UNIT_CHECK(!volk_set_impl(accumulator, "no_such_impl", NULL));
+    UNIT_CHECK(!volk_set_impl(accumulator, "generic", "no_such_impl"));
+    UNIT_CHECK(!volk_set_impl("volk_no_such_kernel", "generic", NULL));
+    UNIT_CHECK(!volk_set_impl(NULL, "generic", NULL));
+    UNIT_CHECK(!accumulator_is_generic(2048, true));
+    UNIT_CHECK(accumulator_is_generic(2048, false));
+    return unit_test_result("dispatcher override");
+}
+
+static void run_child(const char* self,
+                      const char* mode,
+                      const fs::path& dir,
+                      const std::string& config,
+                      std::vector<std::pair<std::string, std::string>> env = {})
+{
+    const fs::path path = dir / mode / "volk" / "volk_config";
+    fs::create_directories(path.parent_path());
+    std::ofstream(path) << config;
+    env.emplace_back("VOLK_CONFIGPATH", (dir / mode).string());
+    env.emplace_back("VOLK_ADAPTIVE", "");
+    const int status = unit_test_run_child(self, mode, env);
+    if (status != 0) {
+        std::cerr << "the " << mode << " test failed" << std::endl;
+    }
+    UNIT_CHECK(status == 0);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc > 2 && strcmp(argv[1], "--child") == 0) {
+        const std::string mode = argv[2];
+        if (mode == "peel") {
+            return child_peel();
+        }
+        if (mode == "buckets") {
+            return child_buckets();
+        }
+        if (mode == "override") {
+            return child_override();
+        }
+        return 1;
+    }
+
+    std::string dir_template =
+        (fs::temp_directory_path() / "volk_test_dispatch.XXXXXX").string();
+    if (!mkdtemp(&dir_template[0])) {
+        std::cerr << "cannot create a temporary directory" << std::endl;
+        return 1;
+    }
+    const fs::path dir = dir_template;
+
+    // an empty volk_config, so that the one in HOME does not apply
+    run_child(argv[0], "peel", dir, "");
+
+    std::string aligned_only, unaligned;
+    accumulator_impls(aligned_only, unaligned);
+    const std::string generic = std::string(accumulator) + " generic generic";
+    if (!aligned_only.empty() && !unaligned.empty()) {
+        run_child(argv[0],
+                  "buckets",
+                  dir,
+                  generic + " 1024 " + aligned_only + " " + unaligned + "\n");
+        run_child(argv[0],
+                  "override",
+                  dir,
+                  generic + "\n",
+                  { { std::string("VOLK_IMPL_") + accumulator, aligned_only } });
+    } else {
+        std::cerr << "no SIMD implementations of " << accumulator
+                  << ", skipping the bucket and override tests" << std::endl;
+    }
+    fs::remove_all(dir);
+
+    return unit_test_result("volk_dispatch");
+}
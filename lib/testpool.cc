@@ -0,0 +1,139 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of VOLK
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include <stdint.h>         // for uintptr_t
+#include <volk/volk_pool.h> // for volk_pool_malloc, volk_pool_free, ...
+#include <cstring>          // for memset
+#include <thread>           // for thread
+#include <vector>           // for vector
+
+#include "unit_test.h" // for UNIT_CHECK, unit_test_result
+
+static volk_pool_stats_t pool_stats()
+{
+    volk_pool_stats_t stats;
+    volk_pool_get_stats(&stats);
+    return stats;
+}
+
+// every size class, one size above the largest class, all written in full
+static void test_round_trip()
+{
+    const volk_pool_stats_t before = pool_stats();
+    const size_t sizes[] = { 1, 63, 64, 65, 1000, 4096, 100000, 4u << 20, 5u << 20 };
+    std::vector<void*> ptrs;
+    for (size_t size : sizes) {
+        void* ptr = volk_pool_malloc(size, 32);
+        UNIT_CHECK(ptr != NULL);
+        if (ptr) {
+            memset(ptr, 0x5a, size);
+            ptrs.push_back(ptr);
+        }
+    }
+    for (void* ptr : ptrs) {
+        volk_pool_free(ptr);
+    }
+    volk_pool_free(NULL); // ignored
+
+    const volk_pool_stats_t after = pool_stats();
+    UNIT_CHECK(after.allocations - before.allocations == ptrs.size());
+    UNIT_CHECK(after.frees - before.frees == ptrs.size());
+    UNIT_CHECK(after.large - before.large == 1);
+    volk_pool_trim();
+    UNIT_CHECK(pool_stats().cached_bytes == 0);
+}
+
+// a freed block is handed out again by the next allocation of its class
+static void test_reuse()
+{
+    volk_pool_trim();
+    void* first = volk_pool_malloc(200, 16);
+    UNIT_CHECK(first != NULL);
+    volk_pool_free(first);
+    UNIT_CHECK(pool_stats().cached_bytes == 256);
+
+    const volk_pool_stats_t before = pool_stats();
+    void* second = volk_pool_malloc(250, 16);
+    const volk_pool_stats_t after = pool_stats();
+    UNIT_CHECK(second == first);
+    UNIT_CHECK(after.hits - before.hits == 1);
+    UNIT_CHECK(after.misses == before.misses);
+    UNIT_CHECK(after.cached_bytes == 0);
+
+    // another size class does not take it
+    volk_pool_free(second);
+    void* other = volk_pool_malloc(1000, 16);
+    UNIT_CHECK(other != second);
+    volk_pool_free(other);
+    volk_pool_trim();
+}
+
+// pooled and passed on alignments alike
+static void test_alignment()
+{
+    const size_t alignments[] = { 1, 2, 8, 16, 32, 64, 128, 512, 4096 };
+    for (size_t alignment : alignments) {
+        for (size_t size = 1; size <= 8192; size = size * 3 + 1) {
+            void* ptr = volk_pool_malloc(size, alignment);
+            UNIT_CHECK(ptr != NULL);
+            UNIT_CHECK((uintptr_t)ptr % alignment == 0);
+            volk_pool_free(ptr);
+        }
+    }
+    // cached blocks keep their alignment when handed out again
+    void* ptr = volk_pool_malloc(100, 64);
+    volk_pool_free(ptr);
+    ptr = volk_pool_malloc(100, 64);
+    UNIT_CHECK((uintptr_t)ptr % 64 == 0);
+    volk_pool_free(ptr);
+    UNIT_CHECK(volk_pool_malloc(0, 64) == NULL);
+    UNIT_CHECK(volk_pool_malloc(64, 0) == NULL);
+    volk_pool_trim();
+}
+
+// blocks freed by another thread go to that thread's cache
+static void test_cross_thread_free()
+{
+    volk_pool_trim();
+    void* ptr = NULL;
+    std::thread producer([&ptr]() {
+        ptr = volk_pool_malloc(3000, 32);
+        memset(ptr, 0x11, 3000);
+    });
+    producer.join();
+    UNIT_CHECK(ptr != NULL);
+
+    volk_pool_free(ptr);
+    UNIT_CHECK(pool_stats().cached_bytes == 4096);
+    void* again = volk_pool_malloc(4000, 32);
+    UNIT_CHECK(again == ptr);
+    volk_pool_free(again);
+
+    // and the other way round, the freeing thread's cache dies with it
+    ptr = volk_pool_malloc(3000, 32);
+    UNIT_CHECK(pool_stats().cached_bytes == 0);
+    std::thread consumer([ptr]() {
+        volk_pool_free(ptr);
+        UNIT_CHECK(pool_stats().cached_bytes == 4096);
+    });
+    consumer.join();
+#if defined(HAVE_PTHREAD_H)
+    UNIT_CHECK(pool_stats().cached_bytes == 0);
+#endif
+}
+
+int main()
+{
+    test_round_trip();
+    test_reuse();
+    test_alignment();
+    test_cross_thread_free();
+
+    return unit_test_result("volk_pool");
+}
@@ -8,6 +8,7 @@
  */
 
 #include <stdbool.h> // for bool, false, true
+#include <cstdlib>   // for getenv
 #include <fstream>   // IWYU pragma: keep
 #include <iostream>  // for operator<<, basic_ostream, endl, char...
 #include <map>       // for map, map<>::iterator, _Rb_tree_iterator
@@ -35,6 +36,18 @@ int main(int argc, char* argv[])
 
     volk_test_params_t test_params(
         def_tol, def_scalar, def_vlen, def_iter, def_benchmark_mode, def_kernel_regex);
+    // VOLK_QA_PERF_COUNTERS=1 adds hardware counters to the timings
+    const char* perf_counters = getenv("VOLK_QA_PERF_COUNTERS");
+    test_params.set_perf_counters(perf_counters && std::string(perf_counters) != "0");
+    // VOLK_QA_INPUT=<distribution> replaces the uniform inputs, see volk_test_input_t
+    const char* input_name = getenv("VOLK_QA_INPUT");
+    volk_test_input_t input = VOLK_TEST_INPUT_UNIFORM;
+    if (input_name && !volk_test_input_from_string(input_name, input)) {
+        std::cerr << "Invalid VOLK_QA_INPUT " << input_name << ", expected one of "
+                  << volk_test_input_names() << std::endl;
+        return 1;
+    }
+    test_params.set_input(input);
     std::vector<volk_test_case_t> test_cases = init_test_list(test_params);
     std::vector<volk_test_results_t> results;
 
@@ -0,0 +1,77 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of VOLK
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef VOLK_UNIT_TEST_H
+#define VOLK_UNIT_TEST_H
+
+#include <iostream> // for operator<<, basic_ostream, endl, cerr
+#include <string>   // for string
+#include <utility>  // for pair
+#include <vector>   // for vector
+
+#if !defined(_WIN32)
+#include <stdlib.h>   // for setenv
+#include <sys/wait.h> // for waitpid, WEXITSTATUS, WIFEXITED
+#include <unistd.h>   // for execvp, fork, _exit
+#endif
+
+/*
+ * Checks for the unit test executables. A failed check is reported and
+ * counted, and the test keeps going; main returns unit_test_result().
+ */
+
+inline unsigned int unit_test_failures = 0;
+
+#define UNIT_CHECK(cond)                                                           \
+    do {                                                                           \
+        if (!(cond)) {                                                             \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": " << #cond << " failed" \
+                      << std::endl;                                                \
+            unit_test_failures++;                                                  \
+        }                                                                          \
+    } while (0)
+
+//! the exit status of a test of \p what, after reporting any failures
+inline int unit_test_result(const char* what)
+{
+    if (unit_test_failures) {
+        std::cerr << unit_test_failures << " " << what << " checks failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+#if !defined(_WIN32)
+/*
+ * Run the test executable again as "self --child mode" with the environment
+ * variables in env set, for settings VOLK only reads when it starts up.
+ * Returns the exit status of the child, -1 if it did not exit normally.
+ */
+inline int
+unit_test_run_child(const char* self,
+                    const char* mode,
+                    const std::vector<std::pair<std::string, std::string>>& env)
+{
+    const pid_t pid = fork();
+    if (pid == 0) {
+        for (const auto& var : env) {
+            setenv(var.first.c_str(), var.second.c_str(), 1);
+        }
+        execlp(self, self, "--child", mode, (char*)NULL);
+        _exit(127);
+    }
+    int status = 0;
+    if (pid < 0 || waitpid(pid, &status, 0) != pid || !WIFEXITED(status)) {
+        return -1;
+    }
+    return WEXITSTATUS(status);
+}
+#endif
+
+#endif /* VOLK_UNIT_TEST_H */
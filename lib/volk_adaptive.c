@@ -0,0 +1,323 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of VOLK
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#if defined(_WIN32)
+#include <direct.h>
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+#include <volk/volk.h>
+#include <volk/volk_prefs.h>
+
+#include "volk_adaptive.h"
+#include "volk_rank_archs.h"
+
+const unsigned int volk_adaptive_min_points[VOLK_MAX_LEN_BUCKETS] = {
+    0, 32, 128, 512, 2048, 8192, 32768, 131072
+};
+
+// every kernel tuned in this process, newest first
+static volk_adaptive_t* volk_adaptive_list = NULL;
+
+static void volk_adaptive_save(void);
+
+// 0 when adaptive dispatch is off, 1 when on, 2 when results are saved too
+static int volk_adaptive_mode(void)
+{
+    const char* env = getenv("VOLK_ADAPTIVE");
+    if (!env || env[0] == '\0' || strcmp(env, "0") == 0) {
+        return 0;
+    }
+    return strcmp(env, "write") == 0 ? 2 : 1;
+}
+
+volk_adaptive_t* volk_adaptive_create(const char* name,
+                                      const char** impl_names,
+                                      const bool* alignment,
+                                      size_t n_impls,
+                                      size_t index_a,
+                                      size_t index_u)
+{
+    if (!volk_adaptive_mode() || volk_rank_archs_overridden(name)) {
+        return NULL;
+    }
+
+    if (n_impls < 2) {
+        return NULL; // nothing to choose from
+    }
+    size_t n_unaligned = 0;
+    for (size_t i = 0; i < n_impls; i++) {
+        n_unaligned += !alignment[i];
+    }
+
+    // one allocation for the state, the candidate lists and the counters
+    const size_t n_counters = VOLK_MAX_LEN_BUCKETS * (n_unaligned + n_impls);
+    const size_t size = sizeof(volk_adaptive_t) + 2 * n_counters * sizeof(uint64_t) +
+                        (n_unaligned + n_impls) * sizeof(size_t);
+    volk_adaptive_t* adaptive = (volk_adaptive_t*)calloc(1, size);
+    if (!adaptive) {
+        return NULL;
+    }
+    adaptive->name = name;
+    adaptive->impl_names = impl_names;
+    adaptive->ranked[0] = index_u;
+    adaptive->ranked[1] = index_a;
+
+    const char* env_trials = getenv("VOLK_ADAPTIVE_TRIALS");
+    const int n_trials = env_trials ? atoi(env_trials) : 16;
+    // one extra round warms up the caches and is not timed
+    adaptive->n_trials = (uint32_t)(n_trials > 0 ? n_trials : 1) + 1;
+
+    uint64_t* counters = (uint64_t*)(adaptive + 1);
+    size_t* candidates = (size_t*)(counters + 2 * n_counters);
+    adaptive->candidates[0] = candidates;
+    adaptive->candidates[1] = candidates + n_unaligned;
+    for (size_t i = 0; i < n_impls; i++) {
+        if (!alignment[i]) {
+            adaptive->candidates[0][adaptive->n_candidates[0]++] = i;
+        }
+        // aligned calls may use any implementation
+        adaptive->candidates[1][adaptive->n_candidates[1]++] = i;
+    }
+
+    for (size_t bucket = 0; bucket < VOLK_MAX_LEN_BUCKETS; bucket++) {
+        for (size_t aligned = 0; aligned < 2; aligned++) {
+            volk_adaptive_slot_t* slot = &adaptive->slots[bucket][aligned];
+            const size_t n_candidates = adaptive->n_candidates[aligned];
+            slot->ticks = counters;
+            slot->points = counters + n_candidates;
+            counters += 2 * n_candidates;
+            slot->chosen = n_candidates > 1 ? -1 : (int)adaptive->ranked[aligned];
+        }
+    }
+
+    return adaptive;
+}
+
+volk_adaptive_t* volk_adaptive_publish(volk_adaptive_t** ptr, volk_adaptive_t* adaptive)
+{
+    if (!volk_atomic_cas_ptr(ptr, (volk_adaptive_t*)NULL, adaptive)) {
+        free(adaptive);
+        return volk_atomic_load_acquire(ptr);
+    }
+
+    // the first kernel registers the save, later ones just join the list
+    volk_adaptive_t* head = volk_atomic_load_acquire(&volk_adaptive_list);
+    do {
+        adaptive->next = head;
+        if (volk_atomic_cas_ptr(&volk_adaptive_list, head, adaptive)) {
+            break;
+        }
+        head = volk_atomic_load_acquire(&volk_adaptive_list);
+    } while (true);
+    if (!head && volk_adaptive_mode() == 2) {
+        atexit(volk_adaptive_save);
+    }
+    return adaptive;
+}
+
+void volk_adaptive_record(volk_adaptive_t* adaptive,
+                          unsigned int num_points,
+                          bool aligned,
+                          uint32_t trial,
+                          uint64_t ticks)
+{
+    const size_t bucket = volk_adaptive_bucket(num_points);
+    volk_adaptive_slot_t* slot = &adaptive->slots[bucket][aligned];
+    const size_t n_candidates = adaptive->n_candidates[aligned];
+    const size_t candidate = trial % n_candidates;
+    if (trial >= n_candidates) {
+        volk_atomic_fetch_add(&slot->ticks[candidate], ticks);
+        volk_atomic_fetch_add(&slot->points[candidate], (uint64_t)num_points + 1);
+    }
+
+    // whoever times the last trial picks the winner
+    const uint32_t finished = volk_atomic_fetch_add(&slot->finished, 1) + 1;
+    if (finished != adaptive->n_trials * n_candidates) {
+        return;
+    }
+    size_t best = 0;
+    double best_cost = -1.0;
+    for (size_t i = 0; i < n_candidates; i++) {
+        const uint64_t points = volk_atomic_load_acquire(&slot->points[i]);
+        const double cost =
+            (double)volk_atomic_load_acquire(&slot->ticks[i]) / (double)points;
+        if (points && (best_cost < 0.0 || cost < best_cost)) {
+            best = i;
+            best_cost = cost;
+        }
+    }
+    volk_atomic_store_release(&slot->chosen, (int)adaptive->candidates[aligned][best]);
+}
+
+/*
+ * Render the choices of a kernel as a volk_config line, with a length
+ * bucket wherever the choice changes. Returns false if nothing was tuned.
+ */
+static bool volk_adaptive_config_line(const volk_adaptive_t* adaptive,
+                                      char* line,
+                                      size_t len)
+{
+    bool tuned = false;
+    size_t index[VOLK_MAX_LEN_BUCKETS][2];
+    for (size_t bucket = 0; bucket < VOLK_MAX_LEN_BUCKETS; bucket++) {
+        for (size_t aligned = 0; aligned < 2; aligned++) {
+            const int chosen = volk_atomic_load_acquire(
+                (int*)&adaptive->slots[bucket][aligned].chosen);
+            // untuned buckets keep the choice of the bucket below
+            if (chosen >= 0 && adaptive->n_candidates[aligned] > 1) {
+                index[bucket][aligned] = (size_t)chosen;
+                tuned = true;
+            } else {
+                index[bucket][aligned] =
+                    bucket ? index[bucket - 1][aligned] : adaptive->ranked[aligned];
+            }
+        }
+    }
+    if (!tuned) {
+        return false;
+    }
+
+    int used = snprintf(line,
+                        len,
+                        "%s %s %s",
+                        adaptive->name,
+                        adaptive->impl_names[index[0][1]],
+                        adaptive->impl_names[index[0][0]]);
+    for (size_t bucket = 1; bucket < VOLK_MAX_LEN_BUCKETS; bucket++) {
+        if (index[bucket][0] == index[bucket - 1][0] &&
+            index[bucket][1] == index[bucket - 1][1]) {
+            continue;
+        }
+        if (used < 0 || (size_t)used >= len) {
+            return false;
+        }
+        used += snprintf(line + used,
+                         len - used,
+                         " %u %s %s",
+                         volk_adaptive_min_points[bucket],
+                         adaptive->impl_names[index[bucket][1]],
+                         adaptive->impl_names[index[bucket][0]]);
+    }
+    return used > 0 && (size_t)used < len;
+}
+
+/*
+ * Is the config line about a kernel that volk_adaptive_write_section
+ * writes a new line for? Kernels that took part in tuning without
+ * finishing a bucket keep their line.
+ */
+static bool volk_adaptive_is_tuned(const char* line)
+{
+    char name[128];
+    if (sscanf(line, "%127s", name) != 1) {
+        return false;
+    }
+    char tuned_line[2048];
+    const volk_adaptive_t* adaptive = volk_atomic_load_acquire(&volk_adaptive_list);
+    for (; adaptive; adaptive = adaptive->next) {
+        if (strcmp(adaptive->name, name) == 0) {
+            return volk_adaptive_config_line(adaptive, tuned_line, sizeof(tuned_line));
+        }
+    }
+    return false;
+}
+
+static void volk_adaptive_write_section(FILE* out)
+{
+    char line[2048];
+    const volk_adaptive_t* adaptive = volk_atomic_load_acquire(&volk_adaptive_list);
+    for (; adaptive; adaptive = adaptive->next) {
+        if (volk_adaptive_config_line(adaptive, line, sizeof(line))) {
+            fprintf(out, "%s\n", line);
+        }
+    }
+}
+
+/*
+ * Store the tuned choices in this host's section of volk_config. Lines
+ * of other sections and of kernels that were not tuned are kept as is.
+ */
+static void volk_adaptive_save(void)
+{
+    char path[1024];
+    char tmp_path[1100];
+    volk_get_config_path(path, false);
+    if (path[0] == '\0') {
+        return;
+    }
+    // the volk directory of the config may not exist yet
+    char dir[1024];
+    snprintf(dir, sizeof(dir), "%s", path);
+    char* slash = strrchr(dir, '/');
+    if (slash) {
+        *slash = '\0';
+#if defined(_WIN32)
+        _mkdir(dir);
+#else
+        mkdir(dir, 0755);
+#endif
+    }
+
+    snprintf(tmp_path, sizeof(tmp_path), "%s.%d.tmp", path, (int)getpid());
+    FILE* out = fopen(tmp_path, "w");
+    if (!out) {
+        fprintf(stderr, "Volk warning: cannot save adaptive results to %s\n", path);
+        return;
+    }
+
+    const char* fingerprint = volk_get_cpu_fingerprint();
+    bool in_section = false;
+    bool wrote_section = false;
+    char line[2048];
+    char section[256];
+    FILE* in = fopen(path, "r");
+    size_t line_len = 0;
+    while (in && fgets(line, sizeof(line), in)) {
+        line_len = strlen(line);
+        if (volk_parse_section(line, section, sizeof(section))) {
+            if (in_section && !wrote_section) {
+                volk_adaptive_write_section(out);
+                wrote_section = true;
+            }
+            in_section = strcmp(section, fingerprint) == 0;
+        } else if (in_section && volk_adaptive_is_tuned(line)) {
+            continue; // replaced by the new results
+        }
+        fputs(line, out);
+    }
+    if (in) {
+        fclose(in);
+    }
+    if (!wrote_section) {
+        if (line_len && line[line_len - 1] != '\n') {
+            fputc('\n', out);
+        }
+        if (!in_section) {
+            fprintf(out, "[%s]\n", fingerprint);
+        }
+        volk_adaptive_write_section(out);
+    }
+
+    bool ok = fclose(out) == 0;
+#if defined(_WIN32)
+    remove(path);
+#endif
+    if (!ok || rename(tmp_path, path)) {
+        remove(tmp_path);
+        fprintf(stderr, "Volk warning: cannot save adaptive results to %s\n", path);
+    }
+}
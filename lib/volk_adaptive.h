@@ -0,0 +1,129 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of VOLK
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_VOLK_ADAPTIVE_H
+#define INCLUDED_VOLK_ADAPTIVE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <volk/volk_prefs.h>
+
+#include "volk_atomic.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * In process tuning of the implementation choice.
+ *
+ * Enabled by setting VOLK_ADAPTIVE in the environment of a library built
+ * with ENABLE_ADAPTIVE_DISPATCH. The dispatcher then hands the first calls
+ * of every length bucket round robin to all candidate implementations,
+ * times them and locks in the one with the fewest ticks per point.
+ * Aligned and unaligned calls are tuned separately. VOLK_ADAPTIVE=write
+ * also stores the result in this host's section of volk_config at exit.
+ * VOLK_ADAPTIVE_TRIALS sets the number of timed calls per candidate.
+ */
+
+//! returned by volk_adaptive_select for calls that need no timing
+#define VOLK_ADAPTIVE_NO_TRIAL ((uint32_t)-1)
+
+//! smallest num_points of each tuned length bucket
+extern const unsigned int volk_adaptive_min_points[VOLK_MAX_LEN_BUCKETS];
+
+typedef struct volk_adaptive_slot {
+    int chosen;         // implementation index once tuned, -1 while tuning
+    uint32_t claimed;   // trial calls handed out
+    uint32_t finished;  // trial calls timed
+    uint64_t* ticks;    // ticks spent per candidate
+    uint64_t* points;   // points processed per candidate, plus one per call
+} volk_adaptive_slot_t;
+
+typedef struct volk_adaptive {
+    const char* name;         // kernel name
+    const char** impl_names;  // implementation names of the machine
+    uint32_t n_trials;        // rounds over the candidates, the first is not timed
+    size_t n_candidates[2];   // candidates for unaligned [0] and aligned [1] calls
+    size_t* candidates[2];    // implementation indices of the candidates
+    size_t ranked[2];         // what volk_rank_archs picked, used while tuning
+    volk_adaptive_slot_t slots[VOLK_MAX_LEN_BUCKETS][2];
+    struct volk_adaptive* next; // list of all tuned kernels
+} volk_adaptive_t;
+
+/*
+ * Start tuning a kernel. Returns NULL when VOLK_ADAPTIVE is not set, when
+ * VOLK_GENERIC or VOLK_IMPL_<kernel> pins the kernel, when there is no
+ * choice to make, or when out of memory.
+ */
+volk_adaptive_t* volk_adaptive_create(const char* name,
+                                      const char** impl_names,
+                                      const bool* alignment,
+                                      size_t n_impls,
+                                      size_t index_a,
+                                      size_t index_u);
+
+/*
+ * Store a state created by volk_adaptive_create in *ptr unless another
+ * thread got there first, in which case it is freed. Returns the state
+ * now in *ptr.
+ */
+volk_adaptive_t* volk_adaptive_publish(volk_adaptive_t** ptr, volk_adaptive_t* adaptive);
+
+//! finish a trial call started by volk_adaptive_select
+void volk_adaptive_record(volk_adaptive_t* adaptive,
+                          unsigned int num_points,
+                          bool aligned,
+                          uint32_t trial,
+                          uint64_t ticks);
+
+static inline size_t volk_adaptive_bucket(unsigned int num_points)
+{
+    size_t bucket = 0;
+    while (bucket + 1 < VOLK_MAX_LEN_BUCKETS &&
+           num_points >= volk_adaptive_min_points[bucket + 1]) {
+        bucket++;
+    }
+    return bucket;
+}
+
+/*
+ * Pick the implementation for a call. While the bucket is being tuned
+ * *trial is set to the trial number, and the call must be timed and
+ * passed to volk_adaptive_record. Otherwise it is VOLK_ADAPTIVE_NO_TRIAL.
+ */
+static inline size_t volk_adaptive_select(volk_adaptive_t* adaptive,
+                                          unsigned int num_points,
+                                          bool aligned,
+                                          uint32_t* trial)
+{
+    const size_t bucket = volk_adaptive_bucket(num_points);
+    volk_adaptive_slot_t* slot = &adaptive->slots[bucket][aligned];
+    const int chosen = volk_atomic_load_acquire(&slot->chosen);
+    if (chosen >= 0) {
+        *trial = VOLK_ADAPTIVE_NO_TRIAL;
+        return (size_t)chosen;
+    }
+
+    const size_t n_candidates = adaptive->n_candidates[aligned];
+    const uint32_t call = volk_atomic_fetch_add(&slot->claimed, 1);
+    if (call >= adaptive->n_trials * n_candidates) {
+        // every trial is handed out, the last ones are still running
+        *trial = VOLK_ADAPTIVE_NO_TRIAL;
+        return adaptive->ranked[aligned];
+    }
+    *trial = call;
+    return adaptive->candidates[aligned][call % n_candidates];
+}
+
+#ifdef __cplusplus
+}
+#endif
+#endif /*INCLUDED_VOLK_ADAPTIVE_H*/
@@ -0,0 +1,102 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of VOLK
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_VOLK_ATOMIC_H
+#define INCLUDED_VOLK_ATOMIC_H
+
+/*
+ * Minimal atomics used to publish the dispatch table between threads,
+ * and to read the per thread kernel statistics while they are updated,
+ * plus the storage class of the per thread data itself.
+ * GCC and Clang provide the __atomic builtins for C; MSVC compiles the
+ * library as C++, so we fall back to volatile accesses plus fences there.
+ */
+
+#if defined(_MSC_VER)
+#define VOLK_THREAD_LOCAL __declspec(thread)
+#else
+#define VOLK_THREAD_LOCAL __thread
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#include <atomic>
+
+template <class T>
+static inline T volk_atomic_load_acquire(T* ptr)
+{
+    T val = *(volatile T*)ptr;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return val;
+}
+
+template <class T, class U>
+static inline void volk_atomic_store_release(T* ptr, U val)
+{
+    std::atomic_thread_fence(std::memory_order_release);
+    *(volatile T*)ptr = val;
+}
+
+template <class T>
+static inline T volk_atomic_load_relaxed(T* ptr)
+{
+    return *(volatile T*)ptr;
+}
+
+template <class T, class U>
+static inline void volk_atomic_store_relaxed(T* ptr, U val)
+{
+    *(volatile T*)ptr = val;
+}
+
+// returns the value before the addition, for 32 and 64 bit integers
+template <class T, class U>
+static inline T volk_atomic_fetch_add(T* ptr, U val)
+{
+    if (sizeof(T) == 8) {
+        return (T)_InterlockedExchangeAdd64((volatile __int64*)ptr, (__int64)val);
+    }
+    return (T)_InterlockedExchangeAdd((volatile long*)ptr, (long)val);
+}
+
+// compare and swap for pointer sized values, true on success
+template <class T>
+static inline bool volk_atomic_cas_ptr(T* ptr, T expected, T desired)
+{
+    return _InterlockedCompareExchangePointer(
+               (void* volatile*)ptr, (void*)desired, (void*)expected) ==
+           (void*)expected;
+}
+
+#else
+
+#define volk_atomic_load_acquire(ptr) __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+
+#define volk_atomic_store_release(ptr, val) \
+    __atomic_store_n((ptr), (val), __ATOMIC_RELEASE)
+
+#define volk_atomic_load_relaxed(ptr) __atomic_load_n((ptr), __ATOMIC_RELAXED)
+
+#define volk_atomic_store_relaxed(ptr, val) \
+    __atomic_store_n((ptr), (val), __ATOMIC_RELAXED)
+
+// returns the value before the addition, for 32 and 64 bit integers
+#define volk_atomic_fetch_add(ptr, val) __atomic_fetch_add((ptr), (val), __ATOMIC_ACQ_REL)
+
+// compare and swap for pointer sized values, true on success
+#define volk_atomic_cas_ptr(ptr, expected, desired)                           \
+    __extension__({                                                           \
+        __typeof__(*(ptr)) __volk_expected = (expected);                      \
+        __atomic_compare_exchange_n(                                          \
+            (ptr), &__volk_expected, (desired), 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE); \
+    })
+
+#endif
+
+#endif /* INCLUDED_VOLK_ATOMIC_H */
@@ -0,0 +1,201 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of VOLK
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <volk/volk_circbuf.h>
+
+#include "volk_atomic.h"
+
+#if !defined(_WIN32)
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+#endif
+
+/*
+ * The read and write positions count bytes modulo twice the size, so a
+ * full buffer is told apart from an empty one without a spare byte. Only
+ * the writer stores written and only the reader stores read.
+ */
+struct volk_circbuf {
+    char* data; // size bytes, mapped again at data + size
+    size_t size;
+    size_t written;
+    size_t read;
+};
+
+static inline size_t circbuf_offset(const volk_circbuf_t* buf, size_t pos)
+{
+    return pos >= buf->size ? pos - buf->size : pos;
+}
+
+static inline size_t circbuf_advance(const volk_circbuf_t* buf, size_t pos, size_t bytes)
+{
+    pos += bytes;
+    return pos >= 2 * buf->size ? pos - 2 * buf->size : pos;
+}
+
+static inline size_t circbuf_fill(const volk_circbuf_t* buf, size_t written, size_t read)
+{
+    return written >= read ? written - read : written + 2 * buf->size - read;
+}
+
+#if !defined(_WIN32)
+// a file descriptor of size bytes of anonymous shared memory, -1 on failure
+static int circbuf_open_memory(size_t size)
+{
+    int fd = -1;
+#if defined(__linux__)
+#if defined(SYS_memfd_create)
+    fd = (int)syscall(SYS_memfd_create, "volk_circbuf", 0);
+#endif
+    if (fd < 0) {
+        // kernels before memfd_create
+        char path[] = "/dev/shm/volk_circbuf_XXXXXX";
+        fd = mkstemp(path);
+        if (fd >= 0) {
+            unlink(path);
+        }
+    }
+#else
+    static unsigned int counter = 0;
+    char name[64];
+    snprintf(name,
+             sizeof(name),
+             "/volk_circbuf_%ld_%u",
+             (long)getpid(),
+             volk_atomic_fetch_add(&counter, 1));
+    fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd >= 0) {
+        shm_unlink(name);
+    }
+#endif
+    if (fd >= 0 && ftruncate(fd, (off_t)size) != 0) {
+        close(fd);
+        fd = -1;
+    }
+    return fd;
+}
+
+static char* circbuf_map_twice(size_t size)
+{
+    const int fd = circbuf_open_memory(size);
+    if (fd < 0) {
+        fprintf(stderr,
+                "VOLK: Error creating circular buffer memory: %s\n",
+                strerror(errno));
+        return NULL;
+    }
+    // reserve both halves at once, then map the memory over each of them
+    char* data =
+        (char*)mmap(NULL, 2 * size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    for (int half = 0; half < 2 && data != (char*)MAP_FAILED; half++) {
+        if (mmap(data + half * size,
+                 size,
+                 PROT_READ | PROT_WRITE,
+                 MAP_SHARED | MAP_FIXED,
+                 fd,
+                 0) == MAP_FAILED) {
+            munmap(data, 2 * size);
+            data = (char*)MAP_FAILED;
+        }
+    }
+    close(fd);
+    if (data == (char*)MAP_FAILED) {
+        fprintf(stderr, "VOLK: Error mapping circular buffer: %s\n", strerror(errno));
+        return NULL;
+    }
+    return data;
+}
+#endif
+
+volk_circbuf_t* volk_circbuf_create(size_t size, size_t item_size)
+{
+#if defined(_WIN32)
+    (void)size;
+    (void)item_size;
+    fprintf(stderr, "VOLK: Circular buffers are not supported on this platform\n");
+    return NULL;
+#else
+    if (size == 0 || item_size == 0) {
+        fprintf(stderr, "VOLK: Error creating circular buffer: size or item size is 0\n");
+        return NULL;
+    }
+    // the smallest multiple of the page size that whole items fill
+    const long sys_page = sysconf(_SC_PAGESIZE);
+    const size_t page = sys_page > 0 ? (size_t)sys_page : 4096;
+    size_t unit = page;
+    while (unit % item_size) {
+        unit += page;
+    }
+    size = (size + unit - 1) / unit * unit;
+
+    volk_circbuf_t* buf = (volk_circbuf_t*)calloc(1, sizeof(volk_circbuf_t));
+    if (!buf) {
+        return NULL;
+    }
+    buf->data = circbuf_map_twice(size);
+    if (!buf->data) {
+        free(buf);
+        return NULL;
+    }
+    buf->size = size;
+    return buf;
+#endif
+}
+
+void volk_circbuf_destroy(volk_circbuf_t* buf)
+{
+    if (!buf) {
+        return;
+    }
+#if !defined(_WIN32)
+    munmap(buf->data, 2 * buf->size);
+#endif
+    free(buf);
+}
+
+size_t volk_circbuf_size(const volk_circbuf_t* buf) { return buf->size; }
+
+void* volk_circbuf_write_ptr(volk_circbuf_t* buf, size_t* writable)
+{
+    const size_t written = buf->written;
+    const size_t read = volk_atomic_load_acquire(&buf->read);
+    if (writable) {
+        *writable = buf->size - circbuf_fill(buf, written, read);
+    }
+    return buf->data + circbuf_offset(buf, written);
+}
+
+void volk_circbuf_produce(volk_circbuf_t* buf, size_t bytes)
+{
+    volk_atomic_store_release(&buf->written, circbuf_advance(buf, buf->written, bytes));
+}
+
+const void* volk_circbuf_read_ptr(volk_circbuf_t* buf, size_t* readable)
+{
+    const size_t read = buf->read;
+    const size_t written = volk_atomic_load_acquire(&buf->written);
+    if (readable) {
+        *readable = circbuf_fill(buf, written, read);
+    }
+    return buf->data + circbuf_offset(buf, read);
+}
+
+void volk_circbuf_consume(volk_circbuf_t* buf, size_t bytes)
+{
+    volk_atomic_store_release(&buf->read, circbuf_advance(buf, buf->read, bytes));
+}
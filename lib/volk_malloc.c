@@ -7,12 +7,25 @@
  * SPDX-License-Identifier: LGPL-3.0-or-later
  */
 
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include <volk/volk_malloc.h>
 
+#include "volk_atomic.h"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#if defined(HAVE_PTHREAD_H)
+#include <pthread.h>
+#endif
+#endif
+
 /*
  * C11 features:
  * see: https://en.cppreference.com/w/c/memory/aligned_alloc
@@ -35,12 +48,8 @@
  */
 
 
-void* volk_malloc(size_t size, size_t alignment)
+static void* volk_aligned_alloc(size_t size, size_t alignment)
 {
-    if ((size == 0) || (alignment == 0)) {
-        fprintf(stderr, "VOLK: Error allocating memory: either size or alignment is 0");
-        return NULL;
-    }
     // Tweak size to satisfy ASAN (the GCC address sanitizer).
     // Calling 'volk_malloc' might therefor result in the allocation of more memory than
     // requested for correct alignment. Any allocation size change here will in general
@@ -77,8 +86,424 @@ void* volk_malloc(size_t size, size_t alignment)
     return ptr;
 }
 
+/*
+ * Huge pages: on Linux an explicit MAP_HUGETLB mapping is tried first. It
+ * needs pages reserved in /proc/sys/vm/nr_hugepages, so when there are none
+ * the memory comes from volk_aligned_alloc aligned to the huge page size and
+ * is marked with MADV_HUGEPAGE for transparent huge pages.
+ */
+#define HUGE_DEFAULT_PAGE_SIZE ((size_t)2 << 20)
+#define HUGE_THRESHOLD_UNSET SIZE_MAX
+
+// minimum size served from huge pages, 0 when only requested by flag
+static size_t huge_threshold = HUGE_THRESHOLD_UNSET;
+
+// case insensitive match of text against one of the words
+static bool huge_parse_word(const char* text, const char* const* words)
+{
+    for (; *words; words++) {
+        const char* t = text;
+        const char* w = *words;
+        while (*t && (*t | 0x20) == *w) {
+            t++;
+            w++;
+        }
+        if (!*t && !*w) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// VOLK_HUGE_PAGES: a switch, or a size with k, M or G suffix
+static size_t huge_parse_env(const char* text)
+{
+    static const char* const on[] = { "1", "on", "true", "yes", NULL };
+    static const char* const off[] = { "", "0", "off", "false", "no", NULL };
+    if (huge_parse_word(text, on)) {
+        return HUGE_DEFAULT_PAGE_SIZE;
+    }
+    if (huge_parse_word(text, off)) {
+        return 0;
+    }
+
+    char* end = NULL;
+    unsigned long long size = strtoull(text, &end, 10);
+    unsigned int shift;
+    switch (*end) {
+    case 'g':
+    case 'G':
+        shift = 30;
+        break;
+    case 'm':
+    case 'M':
+        shift = 20;
+        break;
+    case 'k':
+    case 'K':
+        shift = 10;
+        break;
+    default:
+        shift = 0;
+        break;
+    }
+    // a bare number is more likely a mistyped switch than a byte count
+    if (end == text || !shift || end[1] != '\0' || size > (SIZE_MAX >> shift)) {
+        fprintf(stderr,
+                "Volk warning: VOLK_HUGE_PAGES=%s is not on, off or a size like 64M, "
+                "ignored\n",
+                text);
+        return 0;
+    }
+    return (size_t)size << shift;
+}
+
+void volk_set_huge_page_threshold(size_t size)
+{
+    volk_atomic_store_relaxed(&huge_threshold, size);
+}
+
+size_t volk_get_huge_page_threshold(void)
+{
+    size_t threshold = volk_atomic_load_relaxed(&huge_threshold);
+    if (threshold == HUGE_THRESHOLD_UNSET) {
+        const char* env = getenv("VOLK_HUGE_PAGES");
+        threshold = env ? huge_parse_env(env) : 0;
+        volk_atomic_store_relaxed(&huge_threshold, threshold);
+    }
+    return threshold;
+}
+
+static bool huge_requested(size_t size, unsigned int flags)
+{
+    if (flags & VOLK_MALLOC_HUGE_PAGES) {
+        return true;
+    }
+    const size_t threshold = volk_get_huge_page_threshold();
+    return !(flags & VOLK_MALLOC_NO_HUGE_PAGES) && threshold && size >= threshold;
+}
+
+#if defined(__linux__)
+static size_t base_page = 0;
+static size_t huge_page = 0;
+
+static size_t base_page_size(void)
+{
+    size_t page = volk_atomic_load_relaxed(&base_page);
+    if (!page) {
+        const long sys_page = sysconf(_SC_PAGESIZE);
+        page = sys_page > 0 ? (size_t)sys_page : 4096;
+        volk_atomic_store_relaxed(&base_page, page);
+    }
+    return page;
+}
+
+// the default huge page size of the kernel, which MAP_HUGETLB uses
+static size_t huge_page_size(void)
+{
+    size_t page = volk_atomic_load_relaxed(&huge_page);
+    if (page) {
+        return page;
+    }
+    page = HUGE_DEFAULT_PAGE_SIZE;
+    FILE* meminfo = fopen("/proc/meminfo", "r");
+    if (meminfo) {
+        char line[128];
+        unsigned long kib;
+        while (fgets(line, sizeof(line), meminfo)) {
+            if (sscanf(line, "Hugepagesize: %lu kB", &kib) == 1 && kib) {
+                page = (size_t)kib << 10;
+                break;
+            }
+        }
+        fclose(meminfo);
+    }
+    volk_atomic_store_relaxed(&huge_page, page);
+    return page;
+}
+
+#if defined(MAP_HUGETLB) && defined(HAVE_PTHREAD_H)
+/*
+ * Explicit huge page mappings are recorded so that volk_free can tell them
+ * from heap memory. The list grows as needed and is only searched while it
+ * holds a mapping.
+ */
+#define VOLK_HAVE_MAPPINGS 1
+
+typedef struct mapping {
+    void* addr;
+    size_t length;
+} mapping_t;
+
+static pthread_mutex_t mappings_lock = PTHREAD_MUTEX_INITIALIZER;
+static mapping_t* mappings = NULL;
+static size_t mappings_size = 0;
+static size_t mappings_live = 0; // also read without the lock
+
+// map length bytes with extra mmap flags and record them, NULL on failure
+static void* map_pages(size_t length, int flags)
+{
+    void* ptr = mmap(NULL,
+                     length,
+                     PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | flags,
+                     -1,
+                     0);
+    if (ptr == MAP_FAILED) {
+        return NULL;
+    }
+    pthread_mutex_lock(&mappings_lock);
+    if (mappings_live == mappings_size) {
+        const size_t size = mappings_size ? 2 * mappings_size : 16;
+        mapping_t* grown = (mapping_t*)realloc(mappings, size * sizeof(mapping_t));
+        if (!grown) {
+            pthread_mutex_unlock(&mappings_lock);
+            munmap(ptr, length);
+            return NULL;
+        }
+        mappings = grown;
+        mappings_size = size;
+    }
+    mappings[mappings_live].addr = ptr;
+    mappings[mappings_live].length = length;
+    volk_atomic_store_release(&mappings_live, mappings_live + 1);
+    pthread_mutex_unlock(&mappings_lock);
+    return ptr;
+}
+
+// true if ptr was mapped by map_pages and is now unmapped
+static bool unmap_pages(void* ptr)
+{
+    if (volk_atomic_load_acquire(&mappings_live) == 0 ||
+        ((uintptr_t)ptr & (base_page_size() - 1)) != 0) {
+        return false;
+    }
+    size_t length = 0;
+    pthread_mutex_lock(&mappings_lock);
+    for (size_t i = 0; i < mappings_live; i++) {
+        if (mappings[i].addr == ptr) {
+            length = mappings[i].length;
+            mappings[i] = mappings[mappings_live - 1];
+            volk_atomic_store_release(&mappings_live, mappings_live - 1);
+            break;
+        }
+    }
+    pthread_mutex_unlock(&mappings_lock);
+    if (!length) {
+        return false;
+    }
+    munmap(ptr, length);
+    return true;
+}
+#endif
+
+#if defined(MADV_HUGEPAGE)
+#define VOLK_HAVE_HUGE_PAGES 1
+
+static void* huge_malloc(size_t size, size_t alignment)
+{
+    const size_t page = huge_page_size();
+    if (alignment > page) {
+        return NULL;
+    }
+    const size_t length = (size + page - 1) & ~(page - 1);
+#if defined(VOLK_HAVE_MAPPINGS)
+    void* ptr = map_pages(length, MAP_HUGETLB);
+    if (ptr) {
+        return ptr;
+    }
+#endif
+    void* thp = volk_aligned_alloc(length, page);
+    if (thp) {
+        // only a hint, kernels without transparent huge pages ignore it
+        madvise(thp, length, MADV_HUGEPAGE);
+    }
+    return thp;
+}
+#endif
+
+/*
+ * NUMA: the memory policy system calls are made directly, so that libvolk
+ * does not depend on libnuma. Nodes are preferred rather than bound, so a
+ * full node spills over to the others instead of failing allocations.
+ */
+#define NUMA_MPOL_DEFAULT 0
+#define NUMA_MPOL_PREFERRED 1
+#define NUMA_MPOL_MF_MOVE (1 << 1)
+#define NUMA_MAX_NODES 1024
+
+typedef struct numa_mask {
+    unsigned long bits[NUMA_MAX_NODES / (8 * sizeof(unsigned long))];
+} numa_mask_t;
+
+static void numa_mask_set(numa_mask_t* mask, int node)
+{
+    const size_t word_bits = 8 * sizeof(unsigned long);
+    memset(mask, 0, sizeof(*mask));
+    mask->bits[node / word_bits] = 1ul << (node % word_bits);
+}
+
+static int numa_nodes = 0;
+
+int volk_get_numa_nodes(void)
+{
+    int nodes = volk_atomic_load_relaxed(&numa_nodes);
+    if (nodes) {
+        return nodes;
+    }
+    // a list of ranges like 0-1,3, the highest node counts
+    nodes = 1;
+    FILE* online = fopen("/sys/devices/system/node/online", "r");
+    if (online) {
+        int first, last;
+        char sep;
+        while (fscanf(online, "%d", &first) == 1) {
+            last = first;
+            if (fscanf(online, "%c", &sep) == 1 && sep == '-') {
+                if (fscanf(online, "%d", &last) != 1) {
+                    break;
+                }
+                fscanf(online, "%c", &sep);
+            }
+            if (last + 1 > nodes && last < NUMA_MAX_NODES) {
+                nodes = last + 1;
+            }
+        }
+        fclose(online);
+    }
+    volk_atomic_store_relaxed(&numa_nodes, nodes);
+    return nodes;
+}
+
+int volk_get_numa_node(int* cpu)
+{
+    unsigned int this_cpu = 0, this_node = 0;
+    if (syscall(SYS_getcpu, &this_cpu, &this_node, NULL) != 0) {
+        if (cpu) {
+            *cpu = -1;
+        }
+        return 0;
+    }
+    if (cpu) {
+        *cpu = (int)this_cpu;
+    }
+    return (int)this_node;
+}
+
+int volk_set_numa_memory_node(int node)
+{
+    if (node < 0) {
+        return syscall(SYS_set_mempolicy, NUMA_MPOL_DEFAULT, NULL, 0) == 0 ? 0 : -1;
+    }
+    if (node >= volk_get_numa_nodes()) {
+        return -1;
+    }
+    numa_mask_t mask;
+    numa_mask_set(&mask, node);
+    if (syscall(SYS_set_mempolicy, NUMA_MPOL_PREFERRED, mask.bits, NUMA_MAX_NODES) != 0) {
+        return -1;
+    }
+    return 0;
+}
+
+void* volk_malloc_onnode(size_t size, size_t alignment, int node)
+{
+    if ((size == 0) || (alignment == 0)) {
+        fprintf(stderr, "VOLK: Error allocating memory: either size or alignment is 0");
+        return NULL;
+    }
+    if (node >= volk_get_numa_nodes()) {
+        fprintf(stderr, "VOLK: Error allocating memory: no NUMA node %d\n", node);
+        return NULL;
+    }
+    if (node < 0 || alignment > base_page_size()) {
+        return volk_malloc(size, alignment);
+    }
+    // whole pages from the usual allocator, so the policy covers nothing else
+    size_t page = base_page_size();
+    void* ptr = NULL;
+#if defined(VOLK_HAVE_HUGE_PAGES)
+    if (huge_requested(size, 0)) {
+        page = huge_page_size();
+        ptr = huge_malloc(size, alignment);
+    }
+#endif
+    if (!ptr) {
+        page = base_page_size();
+        ptr = volk_aligned_alloc((size + page - 1) & ~(page - 1), page);
+    }
+    if (!ptr) {
+        return NULL;
+    }
+    // pages the heap touched before are moved, untouched ones land on the node
+    numa_mask_t mask;
+    numa_mask_set(&mask, node);
+    syscall(SYS_mbind,
+            ptr,
+            (size + page - 1) & ~(page - 1),
+            NUMA_MPOL_PREFERRED,
+            mask.bits,
+            NUMA_MAX_NODES,
+            NUMA_MPOL_MF_MOVE);
+    return ptr;
+}
+#else
+int volk_get_numa_nodes(void) { return 1; }
+
+int volk_get_numa_node(int* cpu)
+{
+    if (cpu) {
+        *cpu = -1;
+    }
+    return 0;
+}
+
+int volk_set_numa_memory_node(int node) { return node <= 0 ? 0 : -1; }
+
+void* volk_malloc_onnode(size_t size, size_t alignment, int node)
+{
+    if (node > 0) {
+        fprintf(stderr, "VOLK: Error allocating memory: no NUMA node %d\n", node);
+        return NULL;
+    }
+    return volk_malloc(size, alignment);
+}
+#endif
+
+void* volk_malloc_flags(size_t size, size_t alignment, unsigned int flags)
+{
+    if ((size == 0) || (alignment == 0)) {
+        fprintf(stderr, "VOLK: Error allocating memory: either size or alignment is 0");
+        return NULL;
+    }
+    const size_t padding = (flags & VOLK_MALLOC_PADDED) ? VOLK_PADDING : 0;
+    char* ptr = NULL;
+#if defined(VOLK_HAVE_HUGE_PAGES)
+    if (huge_requested(size + padding, flags)) {
+        ptr = (char*)huge_malloc(size + padding, alignment);
+    }
+#endif
+    if (!ptr) {
+        ptr = (char*)volk_aligned_alloc(size + padding, alignment);
+    }
+    if (ptr && padding) {
+        memset(ptr + size, 0, padding);
+    }
+    return ptr;
+}
+
+void* volk_malloc(size_t size, size_t alignment)
+{
+    return volk_malloc_flags(size, alignment, 0);
+}
+
 void volk_free(void* ptr)
 {
+#if defined(VOLK_HAVE_MAPPINGS)
+    if (ptr && unmap_pages(ptr)) {
+        return;
+    }
+#endif
 #if defined(_MSC_VER) || defined(__MINGW32__)
     _aligned_free(ptr);
 #else
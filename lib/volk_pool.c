@@ -0,0 +1,254 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of VOLK
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <volk/volk_malloc.h>
+#include <volk/volk_pool.h>
+
+#include "volk_atomic.h"
+
+#if defined(HAVE_PTHREAD_H)
+#include <pthread.h>
+#endif
+
+/*
+ * Every block starts with a header of POOL_ALIGNMENT bytes in front of
+ * the memory handed out, so that volk_pool_free finds its size class.
+ * Size classes are the powers of two from 64 bytes to 4 MiB.
+ */
+#define POOL_ALIGNMENT 64
+#define POOL_MIN_SHIFT 6
+#define POOL_N_CLASSES 17
+#define POOL_LARGE POOL_N_CLASSES // passed on to volk_malloc
+#define POOL_MAGIC 0x766f6c6bu
+#define POOL_DEFAULT_MAX_CACHED ((uint64_t)32 << 20)
+
+typedef struct pool_header {
+    uint32_t magic;
+    uint32_t size_class;
+    void* base;               // what volk_malloc returned
+    struct pool_header* next; // free list link while cached
+} pool_header_t;
+
+/*
+ * The cache and counters of one thread. Only the owning thread writes
+ * them, readers use relaxed loads like the kernel statistics. Caches
+ * are never freed: the cache of an exited thread is emptied and adopted
+ * by the next thread that needs one, so its counts add up.
+ */
+typedef struct pool_thread {
+    struct pool_thread* next;
+    void* owner; // NULL while no thread uses this cache
+    pool_header_t* free_list[POOL_N_CLASSES];
+    uint64_t max_cached;
+    uint64_t cached_bytes;
+    uint64_t allocations;
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t large;
+    uint64_t frees;
+    uint64_t releases;
+} pool_thread_t;
+
+#define pool_bump(ptr, val) \
+    volk_atomic_store_relaxed((ptr), volk_atomic_load_relaxed(ptr) + (val))
+
+static VOLK_THREAD_LOCAL pool_thread_t* pool_local = NULL;
+
+// every cache ever created, newest first
+static pool_thread_t* pool_threads = NULL;
+
+static inline size_t pool_class_size(unsigned int size_class)
+{
+    return (size_t)1 << (size_class + POOL_MIN_SHIFT);
+}
+
+static inline unsigned int pool_size_class(size_t size)
+{
+    unsigned int size_class = 0;
+    while (size_class < POOL_N_CLASSES && pool_class_size(size_class) < size) {
+        size_class++;
+    }
+    return size_class;
+}
+
+static void pool_release_all(pool_thread_t* cache)
+{
+    for (unsigned int size_class = 0; size_class < POOL_N_CLASSES; size_class++) {
+        pool_header_t* header = cache->free_list[size_class];
+        while (header) {
+            pool_header_t* next = header->next;
+            volk_free(header->base);
+            pool_bump(&cache->releases, 1);
+            header = next;
+        }
+        cache->free_list[size_class] = NULL;
+    }
+    volk_atomic_store_relaxed(&cache->cached_bytes, 0);
+}
+
+#if defined(HAVE_PTHREAD_H)
+static pthread_key_t pool_exit_key;
+static pthread_once_t pool_exit_once = PTHREAD_ONCE_INIT;
+
+static void pool_thread_exit(void* arg)
+{
+    pool_thread_t* cache = (pool_thread_t*)arg;
+    pool_release_all(cache);
+    pool_local = NULL;
+    volk_atomic_store_release(&cache->owner, (void*)NULL);
+}
+
+static void pool_create_exit_key(void)
+{
+    pthread_key_create(&pool_exit_key, pool_thread_exit);
+}
+#endif
+
+static pool_thread_t* pool_attach(void)
+{
+    // adopt the cache of an exited thread, else push a new one
+    pool_thread_t* cache = volk_atomic_load_acquire(&pool_threads);
+    for (; cache; cache = cache->next) {
+        if (volk_atomic_load_relaxed(&cache->owner) == NULL &&
+            volk_atomic_cas_ptr(&cache->owner, (void*)NULL, (void*)&pool_local)) {
+            break;
+        }
+    }
+    if (!cache) {
+        cache = (pool_thread_t*)calloc(1, sizeof(pool_thread_t));
+        if (!cache) {
+            return NULL;
+        }
+        cache->owner = &pool_local;
+        const char* max_cached = getenv("VOLK_POOL_MAX_CACHED");
+        cache->max_cached =
+            max_cached ? strtoull(max_cached, NULL, 0) : POOL_DEFAULT_MAX_CACHED;
+
+        pool_thread_t* head = volk_atomic_load_acquire(&pool_threads);
+        do {
+            cache->next = head;
+            if (volk_atomic_cas_ptr(&pool_threads, head, cache)) {
+                break;
+            }
+            head = volk_atomic_load_acquire(&pool_threads);
+        } while (true);
+    }
+
+#if defined(HAVE_PTHREAD_H)
+    pthread_once(&pool_exit_once, pool_create_exit_key);
+    pthread_setspecific(pool_exit_key, cache);
+#endif
+    pool_local = cache;
+    return cache;
+}
+
+void* volk_pool_malloc(size_t size, size_t alignment)
+{
+    if ((size == 0) || (alignment == 0)) {
+        fprintf(stderr, "VOLK: Error allocating memory: either size or alignment is 0");
+        return NULL;
+    }
+    pool_thread_t* cache = pool_local;
+    if (!cache && !(cache = pool_attach())) {
+        return NULL;
+    }
+
+    unsigned int size_class = pool_size_class(size);
+    if (alignment > POOL_ALIGNMENT) {
+        size_class = POOL_LARGE;
+    }
+    if (size_class != POOL_LARGE && cache->free_list[size_class]) {
+        pool_header_t* header = cache->free_list[size_class];
+        cache->free_list[size_class] = header->next;
+        volk_atomic_store_relaxed(&cache->cached_bytes,
+                                  cache->cached_bytes - pool_class_size(size_class));
+        pool_bump(&cache->allocations, 1);
+        pool_bump(&cache->hits, 1);
+        return (char*)header + POOL_ALIGNMENT;
+    }
+
+    // the header sits in the last POOL_ALIGNMENT bytes before the block
+    const size_t offset = alignment > POOL_ALIGNMENT ? alignment : POOL_ALIGNMENT;
+    const size_t block = size_class == POOL_LARGE ? size : pool_class_size(size_class);
+    char* base = (char*)volk_malloc(offset + block, offset);
+    if (!base) {
+        return NULL;
+    }
+    pool_header_t* header = (pool_header_t*)(base + offset - POOL_ALIGNMENT);
+    header->magic = POOL_MAGIC;
+    header->size_class = size_class;
+    header->base = base;
+    header->next = NULL;
+    pool_bump(&cache->allocations, 1);
+    pool_bump(size_class == POOL_LARGE ? &cache->large : &cache->misses, 1);
+    return base + offset;
+}
+
+void volk_pool_free(void* ptr)
+{
+    if (!ptr) {
+        return;
+    }
+    pool_header_t* header = (pool_header_t*)((char*)ptr - POOL_ALIGNMENT);
+    if (header->magic != POOL_MAGIC) {
+        fprintf(stderr, "VOLK: volk_pool_free of memory not from volk_pool_malloc\n");
+        return;
+    }
+    pool_thread_t* cache = pool_local;
+    if (!cache) {
+        cache = pool_attach();
+    }
+    if (cache) {
+        pool_bump(&cache->frees, 1);
+    }
+
+    const unsigned int size_class = header->size_class;
+    if (size_class == POOL_LARGE || !cache ||
+        cache->cached_bytes + pool_class_size(size_class) > cache->max_cached) {
+        volk_free(header->base);
+        if (cache && size_class != POOL_LARGE) {
+            pool_bump(&cache->releases, 1);
+        }
+        return;
+    }
+    header->next = cache->free_list[size_class];
+    cache->free_list[size_class] = header;
+    pool_bump(&cache->cached_bytes, pool_class_size(size_class));
+}
+
+void volk_pool_trim(void)
+{
+    if (pool_local) {
+        pool_release_all(pool_local);
+    }
+}
+
+void volk_pool_get_stats(volk_pool_stats_t* stats)
+{
+    memset(stats, 0, sizeof(*stats));
+    pool_thread_t* cache = volk_atomic_load_acquire(&pool_threads);
+    for (; cache; cache = cache->next) {
+        stats->allocations += volk_atomic_load_relaxed(&cache->allocations);
+        stats->hits += volk_atomic_load_relaxed(&cache->hits);
+        stats->misses += volk_atomic_load_relaxed(&cache->misses);
+        stats->large += volk_atomic_load_relaxed(&cache->large);
+        stats->frees += volk_atomic_load_relaxed(&cache->frees);
+        stats->releases += volk_atomic_load_relaxed(&cache->releases);
+        stats->cached_bytes += volk_atomic_load_relaxed(&cache->cached_bytes);
+        if (volk_atomic_load_relaxed(&cache->owner) != NULL) {
+            stats->threads++;
+        }
+    }
+}
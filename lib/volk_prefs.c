@@ -7,6 +7,7 @@
  * SPDX-License-Identifier: LGPL-3.0-or-later
  */
 
+#include <ctype.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -18,7 +19,9 @@
 #else
 #include <unistd.h>
 #endif
+#include <volk/volk.h>
 #include <volk/volk_prefs.h>
+#include <volk_prefs_cache.h>
 
 void volk_get_config_path(char* path, bool read)
 {
@@ -72,36 +75,178 @@ void volk_get_config_path(char* path, bool read)
     return;
 }
 
-size_t volk_load_preferences(volk_arch_pref_t** prefs_res)
+bool volk_parse_preference(const char* line, volk_arch_pref_t* pref)
+{
+    memset(pref, 0, sizeof(*pref));
+    if (sscanf(line, "%127s %127s %127s", pref->name, pref->impl_a, pref->impl_u) != 3) {
+        return false;
+    }
+    return strncmp(pref->name, "volk_", 5) == 0;
+}
+
+bool volk_parse_len_preference(const char* line, volk_len_pref_t* len_pref)
+{
+    char impl_a[128];
+    char impl_u[128];
+    int consumed = 0;
+    memset(len_pref, 0, sizeof(*len_pref));
+    if (sscanf(line,
+               "%127s %127s %127s%n",
+               len_pref->name,
+               impl_a,
+               impl_u,
+               &consumed) != 3 ||
+        strncmp(len_pref->name, "volk_", 5)) {
+        return false;
+    }
+
+    // optional vector length buckets, kept in ascending order
+    line += consumed;
+    while (len_pref->n_buckets < VOLK_MAX_LEN_BUCKETS) {
+        volk_len_pref_bucket_t* b = len_pref->buckets + len_pref->n_buckets;
+        if (sscanf(line,
+                   "%u %127s %127s%n",
+                   &b->min_points,
+                   b->impl_a,
+                   b->impl_u,
+                   &consumed) != 3) {
+            break;
+        }
+        if (len_pref->n_buckets > 0 && b->min_points <= b[-1].min_points) {
+            fprintf(stderr,
+                    "Volk warning: ignoring unordered length bucket for %s\n",
+                    len_pref->name);
+            break;
+        }
+        len_pref->n_buckets++;
+        line += consumed;
+    }
+    return len_pref->n_buckets > 0;
+}
+
+bool volk_parse_section(const char* line, char* section, size_t len)
+{
+    while (isspace((unsigned char)*line)) {
+        line++;
+    }
+    if (*line != '[') {
+        return false;
+    }
+    const char* end = strchr(++line, ']');
+    if (!end || (size_t)(end - line) >= len) {
+        return false;
+    }
+    memcpy(section, line, end - line);
+    section[end - line] = '\0';
+    return true;
+}
+
+typedef struct volk_pref_list {
+    void* items;
+    size_t n_items;
+    size_t capacity;
+} volk_pref_list_t;
+
+static bool volk_pref_list_append(volk_pref_list_t* list, const void* item, size_t size)
+{
+    if (list->n_items == list->capacity) {
+        size_t capacity = list->capacity ? 2 * list->capacity : 64;
+        void* new_items = realloc(list->items, capacity * size);
+        if (!new_items) {
+            printf("volk_load_preferences: bad malloc\n");
+            return false;
+        }
+        list->items = new_items;
+        list->capacity = capacity;
+    }
+    memcpy((char*)list->items + list->n_items++ * size, item, size);
+    return true;
+}
+
+// the entries of volk_config for one host, or for all of them
+typedef struct volk_pref_lists {
+    volk_pref_list_t prefs;
+    volk_pref_list_t len_prefs;
+} volk_pref_lists_t;
+
+static bool volk_pref_lists_append(volk_pref_lists_t* lists,
+                                   const volk_arch_pref_t* pref,
+                                   volk_len_pref_t* len_pref)
+{
+    if (len_pref) {
+        len_pref->pref = (uint32_t)lists->prefs.n_items;
+        if (!volk_pref_list_append(&lists->len_prefs, len_pref, sizeof(*len_pref))) {
+            return false;
+        }
+    }
+    return volk_pref_list_append(&lists->prefs, pref, sizeof(*pref));
+}
+
+size_t volk_load_len_preferences(volk_arch_pref_t** prefs_res,
+                                 volk_len_pref_t** len_prefs_res,
+                                 size_t* n_len_prefs)
 {
     FILE* config_file;
-    char path[512], line[512];
-    size_t n_arch_prefs = 0;
-    volk_arch_pref_t* prefs = NULL;
+    char path[512], line[2048], section[256];
+    volk_arch_pref_t pref;
+    volk_len_pref_t len_pref;
+    volk_pref_lists_t global = { { NULL, 0, 0 }, { NULL, 0, 0 } };
+    volk_pref_lists_t host = { { NULL, 0, 0 }, { NULL, 0, 0 } };
+
+    if (len_prefs_res) {
+        *len_prefs_res = NULL;
+        *n_len_prefs = 0;
+    }
 
     // get the config path
     volk_get_config_path(path, true);
     if (!path[0])
-        return n_arch_prefs; // no prefs found
+        return 0; // no prefs found
     config_file = fopen(path, "r");
     if (!config_file)
-        return n_arch_prefs; // no prefs found
+        return 0; // no prefs found
 
-    // reset the file pointer and write the prefs into volk_arch_prefs
-    while (fgets(line, sizeof(line), config_file) != NULL) {
-        void* new_prefs = realloc(prefs, (n_arch_prefs + 1) * sizeof(*prefs));
-        if (!new_prefs) {
-            printf("volk_load_preferences: bad malloc\n");
-            break;
+    // lines before the first [section] apply to every host, lines in
+    // a section only to the host whose fingerprint names it
+    const char* fingerprint = volk_get_cpu_fingerprint();
+    volk_pref_lists_t* target = &global;
+    bool ok = true;
+    while (ok && fgets(line, sizeof(line), config_file) != NULL) {
+        if (volk_parse_section(line, section, sizeof(section))) {
+            target = strcmp(section, fingerprint) ? NULL : &host;
+            continue;
         }
-        prefs = (volk_arch_pref_t*)new_prefs;
-        volk_arch_pref_t* p = prefs + n_arch_prefs;
-        if (sscanf(line, "%s %s %s", p->name, p->impl_a, p->impl_u) == 3 &&
-            !strncmp(p->name, "volk_", 5)) {
-            n_arch_prefs++;
+        if (target && volk_parse_preference(line, &pref)) {
+            const bool has_len =
+                len_prefs_res && volk_parse_len_preference(line, &len_pref);
+            ok = volk_pref_lists_append(target, &pref, has_len ? &len_pref : NULL);
         }
     }
     fclose(config_file);
-    *prefs_res = prefs;
-    return n_arch_prefs;
+
+    // host specific entries come first, so they win over global ones
+    const volk_arch_pref_t* global_prefs = (const volk_arch_pref_t*)global.prefs.items;
+    volk_len_pref_t* global_len_prefs = (volk_len_pref_t*)global.len_prefs.items;
+    for (size_t i = 0, j = 0; ok && i < global.prefs.n_items; i++) {
+        volk_len_pref_t* len = NULL;
+        if (j < global.len_prefs.n_items && global_len_prefs[j].pref == i) {
+            len = global_len_prefs + j++;
+        }
+        ok = volk_pref_lists_append(&host, global_prefs + i, len);
+    }
+    free(global.prefs.items);
+    free(global.len_prefs.items);
+    *prefs_res = (volk_arch_pref_t*)host.prefs.items;
+    if (len_prefs_res) {
+        *len_prefs_res = (volk_len_pref_t*)host.len_prefs.items;
+        *n_len_prefs = host.len_prefs.n_items;
+    } else {
+        free(host.len_prefs.items);
+    }
+    return host.prefs.n_items;
+}
+
+size_t volk_load_preferences(volk_arch_pref_t** prefs_res)
+{
+    return volk_load_len_preferences(prefs_res, NULL, NULL);
 }
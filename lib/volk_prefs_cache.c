@@ -0,0 +1,396 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of VOLK
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#if defined(_WIN32)
+#include <process.h>
+#define getpid _getpid
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <volk_prefs_cache.h>
+
+#define VOLK_PREFS_CACHE_MAGIC "VOLKPRC"
+#define VOLK_PREFS_CACHE_VERSION 3
+
+/*
+ * On disk layout, native endianness:
+ *   header | uint32_t slots[n_slots] | uint32_t len_slots[n_len_slots] |
+ *   volk_arch_pref_t prefs[n_prefs] | volk_len_pref_t len_prefs[n_len_prefs]
+ * The header is a multiple of 8 bytes and both slot counts are powers of
+ * two >= 2, so the records are suitably aligned in the mapping as well.
+ */
+typedef struct volk_prefs_cache_header {
+    char magic[8];
+    uint32_t version;
+    uint32_t pref_size;     // sizeof(volk_arch_pref_t), guards layout changes
+    uint32_t len_pref_size; // sizeof(volk_len_pref_t), likewise
+    uint32_t reserved;
+    uint64_t source_mtime;
+    uint64_t source_mtime_nsec; // edits within the same second change this
+    uint64_t source_size;
+    uint64_t n_prefs;
+    uint64_t n_slots;
+    uint64_t n_len_prefs;
+    uint64_t n_len_slots;
+    char fingerprint[256];
+} volk_prefs_cache_header_t;
+
+static uint64_t volk_prefs_hash(const char* str)
+{
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ULL;
+    while (*str) {
+        hash ^= (unsigned char)*str++;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// the sub second part of the modification time, where the platform has one
+static uint64_t volk_prefs_mtime_nsec(const struct stat* source)
+{
+#if defined(__APPLE__)
+    return (uint64_t)source->st_mtimespec.tv_nsec;
+#elif defined(_WIN32)
+    (void)source;
+    return 0;
+#else
+    return (uint64_t)source->st_mtim.tv_nsec;
+#endif
+}
+
+static size_t volk_prefs_blob_size(const volk_prefs_cache_header_t* hdr)
+{
+    return sizeof(volk_prefs_cache_header_t) +
+           (hdr->n_slots + hdr->n_len_slots) * sizeof(uint32_t) +
+           hdr->n_prefs * sizeof(volk_arch_pref_t) +
+           hdr->n_len_prefs * sizeof(volk_len_pref_t);
+}
+
+// slots for n records at a load factor of at most one half
+static uint64_t volk_prefs_n_slots(size_t n)
+{
+    uint64_t n_slots = 2;
+    while (n_slots < 2 * (uint64_t)n) {
+        n_slots <<= 1;
+    }
+    return n_slots;
+}
+
+/*
+ * Both record types start with the kernel name, so one open addressing
+ * scheme serves the two tables; stride is the size of a record.
+ */
+static const char* volk_prefs_table_find(const uint32_t* slots,
+                                         uint64_t n_slots,
+                                         const void* records,
+                                         size_t stride,
+                                         const char* kern_name)
+{
+    uint64_t slot = volk_prefs_hash(kern_name) & (n_slots - 1);
+    while (slots[slot]) {
+        const char* name = (const char*)records + (slots[slot] - 1) * stride;
+        if (!strncmp(kern_name, name, 128)) {
+            return name;
+        }
+        slot = (slot + 1) & (n_slots - 1);
+    }
+    return NULL;
+}
+
+static void volk_prefs_table_insert(
+    uint32_t* slots, uint64_t n_slots, const void* records, size_t stride, size_t i)
+{
+    const char* name = (const char*)records + i * stride;
+    uint64_t slot = volk_prefs_hash(name) & (n_slots - 1);
+    while (slots[slot] &&
+           strncmp((const char*)records + (slots[slot] - 1) * stride, name, 128)) {
+        slot = (slot + 1) & (n_slots - 1);
+    }
+    // the first record of a kernel wins
+    if (!slots[slot]) {
+        slots[slot] = (uint32_t)(i + 1);
+    }
+}
+
+// lookups stop at the first empty slot, so insist that there is one
+static bool volk_prefs_table_valid(const uint32_t* slots, uint64_t n_slots, uint64_t n)
+{
+    if (n_slots < 2 || (n_slots & (n_slots - 1)) || n >= n_slots) {
+        return false;
+    }
+    uint64_t used = 0;
+    for (uint64_t i = 0; i < n_slots; i++) {
+        if (slots[i] > n) {
+            return false;
+        }
+        used += slots[i] != 0;
+    }
+    return used < n_slots;
+}
+
+static void volk_pref_index_attach(volk_pref_index_t* index)
+{
+    const volk_prefs_cache_header_t* hdr = (const volk_prefs_cache_header_t*)index->blob;
+    index->n_prefs = hdr->n_prefs;
+    index->n_slots = hdr->n_slots;
+    index->n_len_prefs = hdr->n_len_prefs;
+    index->n_len_slots = hdr->n_len_slots;
+    index->slots = (const uint32_t*)(hdr + 1);
+    index->len_slots = index->slots + index->n_slots;
+    index->prefs = (const volk_arch_pref_t*)(index->len_slots + index->n_len_slots);
+    index->len_prefs = (const volk_len_pref_t*)(index->prefs + index->n_prefs);
+}
+
+static bool volk_prefs_cache_valid(const void* blob,
+                                   size_t blob_size,
+                                   const char* fingerprint,
+                                   const struct stat* source)
+{
+    const volk_prefs_cache_header_t* hdr = (const volk_prefs_cache_header_t*)blob;
+    if (blob_size < sizeof(*hdr) ||
+        memcmp(hdr->magic, VOLK_PREFS_CACHE_MAGIC, sizeof(hdr->magic)) ||
+        hdr->version != VOLK_PREFS_CACHE_VERSION ||
+        hdr->pref_size != sizeof(volk_arch_pref_t) ||
+        hdr->len_pref_size != sizeof(volk_len_pref_t) ||
+        hdr->source_mtime != (uint64_t)source->st_mtime ||
+        hdr->source_mtime_nsec != volk_prefs_mtime_nsec(source) ||
+        hdr->source_size != (uint64_t)source->st_size ||
+        strncmp(hdr->fingerprint, fingerprint, sizeof(hdr->fingerprint))) {
+        return false;
+    }
+    // bound the counts before the sizes derived from them can wrap
+    if (hdr->n_slots > blob_size || hdr->n_len_slots > blob_size ||
+        hdr->n_prefs > blob_size || hdr->n_len_prefs > blob_size ||
+        blob_size < volk_prefs_blob_size(hdr)) {
+        return false;
+    }
+    const uint32_t* slots = (const uint32_t*)(hdr + 1);
+    return volk_prefs_table_valid(slots, hdr->n_slots, hdr->n_prefs) &&
+           volk_prefs_table_valid(
+               slots + hdr->n_slots, hdr->n_len_slots, hdr->n_len_prefs);
+}
+
+static bool volk_pref_index_map(volk_pref_index_t* index,
+                                const char* cache_path,
+                                const char* fingerprint,
+                                const struct stat* source)
+{
+#if defined(_WIN32)
+    FILE* cache_file = fopen(cache_path, "rb");
+    if (!cache_file) {
+        return false;
+    }
+    fseek(cache_file, 0, SEEK_END);
+    long size = ftell(cache_file);
+    fseek(cache_file, 0, SEEK_SET);
+    void* blob = size > 0 ? malloc(size) : NULL;
+    bool ok = blob && fread(blob, 1, size, cache_file) == (size_t)size &&
+              volk_prefs_cache_valid(blob, size, fingerprint, source);
+    fclose(cache_file);
+    if (!ok) {
+        free(blob);
+        return false;
+    }
+    index->mapped = false;
+#else
+    int fd = open(cache_path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat cache_stat;
+    if (fstat(fd, &cache_stat) || cache_stat.st_size <= 0) {
+        close(fd);
+        return false;
+    }
+    size_t size = (size_t)cache_stat.st_size;
+    void* blob = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (blob == MAP_FAILED) {
+        return false;
+    }
+    if (!volk_prefs_cache_valid(blob, size, fingerprint, source)) {
+        munmap(blob, size);
+        return false;
+    }
+    index->mapped = true;
+#endif
+    index->blob = blob;
+    index->blob_size = size;
+    volk_pref_index_attach(index);
+    return true;
+}
+
+static bool volk_pref_index_build(volk_pref_index_t* index,
+                                  const volk_arch_pref_t* prefs,
+                                  size_t n_prefs,
+                                  const volk_len_pref_t* len_prefs,
+                                  size_t n_len_prefs,
+                                  const char* fingerprint,
+                                  const struct stat* source)
+{
+    volk_prefs_cache_header_t sizes;
+    memset(&sizes, 0, sizeof(sizes));
+    sizes.n_prefs = n_prefs;
+    sizes.n_slots = volk_prefs_n_slots(n_prefs);
+    sizes.n_len_prefs = n_len_prefs;
+    sizes.n_len_slots = volk_prefs_n_slots(n_len_prefs);
+
+    size_t size = volk_prefs_blob_size(&sizes);
+    volk_prefs_cache_header_t* hdr = (volk_prefs_cache_header_t*)calloc(1, size);
+    if (!hdr) {
+        return false;
+    }
+    *hdr = sizes;
+    memcpy(hdr->magic, VOLK_PREFS_CACHE_MAGIC, sizeof(hdr->magic));
+    hdr->version = VOLK_PREFS_CACHE_VERSION;
+    hdr->pref_size = sizeof(volk_arch_pref_t);
+    hdr->len_pref_size = sizeof(volk_len_pref_t);
+    hdr->source_mtime = source ? (uint64_t)source->st_mtime : 0;
+    hdr->source_mtime_nsec = source ? volk_prefs_mtime_nsec(source) : 0;
+    hdr->source_size = source ? (uint64_t)source->st_size : 0;
+    strncpy(hdr->fingerprint, fingerprint, sizeof(hdr->fingerprint) - 1);
+
+    uint32_t* slots = (uint32_t*)(hdr + 1);
+    uint32_t* len_slots = slots + hdr->n_slots;
+    volk_arch_pref_t* records = (volk_arch_pref_t*)(len_slots + hdr->n_len_slots);
+    volk_len_pref_t* len_records = (volk_len_pref_t*)(records + n_prefs);
+    if (n_prefs) {
+        memcpy(records, prefs, n_prefs * sizeof(*prefs));
+    }
+    // the first line listing a kernel wins, as it always did
+    for (size_t i = 0; i < n_prefs; i++) {
+        volk_prefs_table_insert(slots, hdr->n_slots, records, sizeof(*records), i);
+    }
+    // and only its buckets apply, those of lines it shadows are dropped
+    size_t n_len = 0;
+    for (size_t i = 0; i < n_len_prefs; i++) {
+        const char* winner = volk_prefs_table_find(
+            slots, hdr->n_slots, records, sizeof(*records), len_prefs[i].name);
+        if (winner == records[len_prefs[i].pref].name) {
+            len_records[n_len] = len_prefs[i];
+            volk_prefs_table_insert(
+                len_slots, hdr->n_len_slots, len_records, sizeof(*len_records), n_len);
+            n_len++;
+        }
+    }
+    hdr->n_len_prefs = n_len;
+
+    index->blob = hdr;
+    index->blob_size = volk_prefs_blob_size(hdr);
+    index->mapped = false;
+    volk_pref_index_attach(index);
+    return true;
+}
+
+static void volk_prefs_cache_write(const volk_pref_index_t* index, const char* cache_path)
+{
+    // write to a private file first so readers never see a partial cache
+    char tmp_path[1200];
+    snprintf(tmp_path, sizeof(tmp_path), "%s.%d.tmp", cache_path, (int)getpid());
+    FILE* cache_file = fopen(tmp_path, "wb");
+    if (!cache_file) {
+        return; // read-only location, e.g. /etc/volk, just skip the cache
+    }
+    bool ok = fwrite(index->blob, 1, index->blob_size, cache_file) == index->blob_size;
+    ok = (fclose(cache_file) == 0) && ok;
+#if defined(_WIN32)
+    remove(cache_path);
+#endif
+    if (!ok || rename(tmp_path, cache_path)) {
+        remove(tmp_path);
+    }
+}
+
+volk_pref_index_t* volk_pref_index_load(const char* fingerprint)
+{
+    volk_pref_index_t* index = (volk_pref_index_t*)calloc(1, sizeof(volk_pref_index_t));
+    if (!index) {
+        return NULL;
+    }
+
+    char path[1024];
+    char cache_path[1100];
+    struct stat source;
+    volk_get_config_path(path, true);
+    bool have_source = path[0] && stat(path, &source) == 0;
+    bool use_cache = have_source && !getenv("VOLK_NO_PREFS_CACHE");
+    if (use_cache) {
+        snprintf(cache_path,
+                 sizeof(cache_path),
+                 "%s.%016llx.cache",
+                 path,
+                 (unsigned long long)volk_prefs_hash(fingerprint));
+        if (volk_pref_index_map(index, cache_path, fingerprint, &source)) {
+            return index;
+        }
+    }
+
+    volk_arch_pref_t* prefs = NULL;
+    volk_len_pref_t* len_prefs = NULL;
+    size_t n_len_prefs = 0;
+    size_t n_prefs = volk_load_len_preferences(&prefs, &len_prefs, &n_len_prefs);
+    bool built = volk_pref_index_build(index,
+                                       prefs,
+                                       n_prefs,
+                                       len_prefs,
+                                       n_len_prefs,
+                                       fingerprint,
+                                       have_source ? &source : NULL);
+    free(prefs);
+    free(len_prefs);
+    if (!built) {
+        free(index);
+        return NULL;
+    }
+    if (use_cache) {
+        volk_prefs_cache_write(index, cache_path);
+    }
+    return index;
+}
+
+const volk_arch_pref_t* volk_pref_index_find(const volk_pref_index_t* index,
+                                             const char* kern_name)
+{
+    return (const volk_arch_pref_t*)volk_prefs_table_find(
+        index->slots, index->n_slots, index->prefs, sizeof(volk_arch_pref_t), kern_name);
+}
+
+const volk_len_pref_t* volk_pref_index_find_len(const volk_pref_index_t* index,
+                                                const char* kern_name)
+{
+    return (const volk_len_pref_t*)volk_prefs_table_find(index->len_slots,
+                                                         index->n_len_slots,
+                                                         index->len_prefs,
+                                                         sizeof(volk_len_pref_t),
+                                                         kern_name);
+}
+
+void volk_pref_index_free(volk_pref_index_t* index)
+{
+    if (!index) {
+        return;
+    }
+#if !defined(_WIN32)
+    if (index->mapped) {
+        munmap(index->blob, index->blob_size);
+        free(index);
+        return;
+    }
+#endif
+    free(index->blob);
+    free(index);
+}
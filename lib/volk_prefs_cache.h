@@ -0,0 +1,100 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of VOLK
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_VOLK_PREFS_CACHE_H
+#define INCLUDED_VOLK_PREFS_CACHE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <volk/volk_prefs.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Vector length buckets of one volk_config line. They live in their own
+ * table keyed by kernel name, so the public volk_arch_pref_t keeps its
+ * layout. Only lines that list buckets get an entry.
+ */
+typedef struct volk_len_pref_bucket {
+    unsigned int min_points; // smallest num_points served by this bucket
+    char impl_a[128];        // best aligned impl for this bucket
+    char impl_u[128];        // best unaligned impl for this bucket
+} volk_len_pref_bucket_t;
+
+typedef struct volk_len_pref {
+    char name[128];     // name of the kernel
+    uint32_t pref;      // index of the pref record of the same line
+    uint32_t n_buckets; // number of buckets following the defaults
+    volk_len_pref_bucket_t buckets[VOLK_MAX_LEN_BUCKETS]; // ascending min_points
+} volk_len_pref_t;
+
+/*
+ * Parse the vector length buckets of a volk_config line.
+ * Returns true if the line is a kernel entry with at least one bucket.
+ */
+bool volk_parse_len_preference(const char* line, volk_len_pref_t* len_pref);
+
+/*
+ * Like volk_load_preferences, additionally returning the buckets of the
+ * loaded lines in len_prefs_res. The pref field of every bucket entry
+ * indexes the records returned in prefs_res.
+ */
+size_t volk_load_len_preferences(volk_arch_pref_t** prefs_res,
+                                 volk_len_pref_t** len_prefs_res,
+                                 size_t* n_len_prefs);
+
+/*
+ * Hashed view of the volk_config prefs.
+ *
+ * The view either points into a memory mapped binary cache file that
+ * sits next to volk_config, or into a heap copy with the same layout
+ * which was freshly built from the text file. The binary cache is
+ * rebuilt whenever volk_config changes, and each host fingerprint gets
+ * its own cache file so hosts sharing a home directory do not fight.
+ */
+typedef struct volk_pref_index {
+    const volk_arch_pref_t* prefs;    // pref records
+    size_t n_prefs;                   // number of pref records
+    const uint32_t* slots;            // open addressing table, pref index + 1 or 0
+    size_t n_slots;                   // size of the slot table, a power of two
+    const volk_len_pref_t* len_prefs; // bucket records of the winning lines
+    size_t n_len_prefs;               // number of bucket records
+    const uint32_t* len_slots;        // like slots, for the bucket records
+    size_t n_len_slots;               // size of len_slots, a power of two
+    void* blob;                    // storage of the cache layout
+    size_t blob_size;              // size of the storage in bytes
+    bool mapped;                   // blob is a file mapping rather than heap memory
+} volk_pref_index_t;
+
+/*
+ * Load the prefs of this host, from the binary cache if it is still
+ * valid, else from volk_config (refreshing the cache on the way).
+ * Setting VOLK_NO_PREFS_CACHE in the environment skips the binary cache.
+ * Returns NULL only when out of memory.
+ */
+volk_pref_index_t* volk_pref_index_load(const char* fingerprint);
+
+//! find the prefs of a kernel, NULL if volk_config does not list it
+const volk_arch_pref_t* volk_pref_index_find(const volk_pref_index_t* index,
+                                             const char* kern_name);
+
+//! find the length buckets of a kernel, NULL if volk_config lists none
+const volk_len_pref_t* volk_pref_index_find_len(const volk_pref_index_t* index,
+                                                const char* kern_name);
+
+//! release an index returned by volk_pref_index_load
+void volk_pref_index_free(volk_pref_index_t* index);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /*INCLUDED_VOLK_PREFS_CACHE_H*/
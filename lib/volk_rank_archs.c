@@ -12,7 +12,10 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <volk/volk.h>
 #include <volk/volk_prefs.h>
+#include <volk_atomic.h>
+#include <volk_prefs_cache.h>
 #include <volk_rank_archs.h>
 
 int volk_get_index(const char* impl_names[], // list of implementations by name
@@ -32,6 +35,81 @@ int volk_get_index(const char* impl_names[], // list of implementations by name
     return volk_get_index(impl_names, n_impls, "generic"); // but we'll fake it for now
 }
 
+static const volk_pref_index_t* volk_get_pref_index(void)
+{
+    static volk_pref_index_t* volk_arch_prefs = NULL;
+
+    // Several threads may race to load the prefs. Every loser frees its
+    // copy, so all callers end up with the same published index.
+    volk_pref_index_t* index = volk_atomic_load_acquire(&volk_arch_prefs);
+    if (!index) {
+        volk_pref_index_t* loaded = volk_pref_index_load(volk_get_cpu_fingerprint());
+        if (!loaded) {
+            return NULL;
+        }
+        if (!volk_atomic_cas_ptr(&volk_arch_prefs, (volk_pref_index_t*)NULL, loaded)) {
+            volk_pref_index_free(loaded);
+        }
+        index = volk_atomic_load_acquire(&volk_arch_prefs);
+    }
+    return index;
+}
+
+static const volk_arch_pref_t* volk_find_arch_pref(const char* kern_name)
+{
+    const volk_pref_index_t* index = volk_get_pref_index();
+    return index ? volk_pref_index_find(index, kern_name) : NULL;
+}
+
+static const volk_len_pref_t* volk_find_len_pref(const char* kern_name)
+{
+    const volk_pref_index_t* index = volk_get_pref_index();
+    return index ? volk_pref_index_find_len(index, kern_name) : NULL;
+}
+
+/*
+ * Look up the VOLK_IMPL_<kernel> environment variable, e.g.
+ * VOLK_IMPL_volk_32f_x2_add_32f="a_avx u_avx". A single name is used for
+ * both the aligned and the unaligned call.
+ */
+static bool volk_env_override(const char* kern_name, bool align, char* impl, size_t len)
+{
+    char env_name[256];
+    snprintf(env_name, sizeof(env_name), "VOLK_IMPL_%s", kern_name);
+    const char* env = getenv(env_name);
+    if (!env) {
+        return false;
+    }
+
+    char impl_a[128];
+    char impl_u[128];
+    int n_tokens = sscanf(env, "%127s %127s", impl_a, impl_u);
+    if (n_tokens < 1) {
+        return false;
+    }
+    const char* name = (align || n_tokens == 1) ? impl_a : impl_u;
+    snprintf(impl, len, "%s", name);
+    return true;
+}
+
+bool volk_rank_archs_overridden(const char* kern_name)
+{
+    char env_impl[128];
+    return getenv("VOLK_GENERIC") ||
+           volk_env_override(kern_name, true, env_impl, sizeof(env_impl));
+}
+
+/*
+ * Implementations named *_nt write their output with non-temporal stores.
+ * They only win on buffers larger than the caches, so they are picked by
+ * volk_config, usually through a length bucket, never by default.
+ */
+static bool volk_is_streaming_impl(const char* impl_name)
+{
+    const size_t len = strlen(impl_name);
+    return len > 3 && strcmp(impl_name + len - 3, "_nt") == 0;
+}
+
 int volk_rank_archs(const char* kern_name,    // name of the kernel to rank
                     const char* impl_names[], // list of implementations by name
                     const int* impl_deps,     // requirement mask per implementation
@@ -41,13 +119,6 @@ int volk_rank_archs(const char* kern_name,    // name of the kernel to rank
 )
 {
     size_t i;
-    static volk_arch_pref_t* volk_arch_prefs;
-    static size_t n_arch_prefs = 0;
-    static int prefs_loaded = 0;
-    if (!prefs_loaded) {
-        n_arch_prefs = volk_load_preferences(&volk_arch_prefs);
-        prefs_loaded = 1;
-    }
 
     // If we've defined VOLK_GENERIC to be anything, always return the
     // 'generic' kernel. Used in GR's QA code.
@@ -56,16 +127,26 @@ int volk_rank_archs(const char* kern_name,    // name of the kernel to rank
         return volk_get_index(impl_names, n_impls, "generic");
     }
 
-    // now look for the function name in the prefs list
-    for (i = 0; i < n_arch_prefs; i++) {
-        if (!strncmp(kern_name,
-                     volk_arch_prefs[i].name,
-                     sizeof(volk_arch_prefs[i].name))) // found it
-        {
-            const char* impl_name =
-                align ? volk_arch_prefs[i].impl_a : volk_arch_prefs[i].impl_u;
-            return volk_get_index(impl_names, n_impls, impl_name);
+    // a per kernel override from the environment beats volk_config
+    char env_impl[128];
+    if (volk_env_override(kern_name, align, env_impl, sizeof(env_impl))) {
+        const int index = volk_get_index(impl_names, n_impls, env_impl);
+        // the same rule as volk_set_impl, unaligned buffers need a u_ impl
+        if (align || !alignment[index]) {
+            return index;
         }
+        fprintf(stderr,
+                "Volk warning: VOLK_IMPL_%s: %s requires aligned buffers, "
+                "ignored for unaligned calls\n",
+                kern_name,
+                env_impl);
+    }
+
+    // now look for the function name in the prefs list
+    const volk_arch_pref_t* pref = volk_find_arch_pref(kern_name);
+    if (pref) {
+        const char* impl_name = align ? pref->impl_a : pref->impl_u;
+        return volk_get_index(impl_names, n_impls, impl_name);
     }
 
     // return the best index with the largest deps
@@ -74,6 +155,9 @@ int volk_rank_archs(const char* kern_name,    // name of the kernel to rank
     int best_value_a = -1;
     int best_value_u = -1;
     for (i = 0; i < n_impls; i++) {
+        if (volk_is_streaming_impl(impl_names[i])) {
+            continue;
+        }
         const signed val = impl_deps[i];
         if (alignment[i] && val > best_value_a) {
             best_index_a = i;
@@ -92,3 +176,34 @@ int volk_rank_archs(const char* kern_name,    // name of the kernel to rank
     // otherwise return the best unaligned
     return best_index_u;
 }
+
+size_t volk_rank_archs_buckets(const char* kern_name,    // name of the kernel to rank
+                               const char* impl_names[], // list of implementations
+                               size_t n_impls,           // number of implementations
+                               volk_len_bucket_t* buckets, // resolved buckets
+                               size_t max_buckets          // capacity of buckets
+)
+{
+    size_t i;
+
+    // VOLK_GENERIC pins every vector length to the generic kernel, and a
+    // VOLK_IMPL_<kernel> override pins them to the implementations it names
+    if (volk_rank_archs_overridden(kern_name)) {
+        return 0;
+    }
+
+    const volk_len_pref_t* pref = volk_find_len_pref(kern_name);
+    if (!pref) {
+        return 0;
+    }
+
+    size_t n_buckets = pref->n_buckets < max_buckets ? pref->n_buckets : max_buckets;
+    for (i = 0; i < n_buckets; i++) {
+        buckets[i].min_points = pref->buckets[i].min_points;
+        buckets[i].index_a =
+            volk_get_index(impl_names, n_impls, pref->buckets[i].impl_a);
+        buckets[i].index_u =
+            volk_get_index(impl_names, n_impls, pref->buckets[i].impl_u);
+    }
+    return n_buckets;
+}
@@ -17,6 +17,12 @@
 extern "C" {
 #endif
 
+typedef struct volk_len_bucket {
+    unsigned int min_points; // smallest num_points served by this bucket
+    size_t index_a;          // aligned implementation index
+    size_t index_u;          // unaligned implementation index
+} volk_len_bucket_t;
+
 int volk_get_index(const char* impl_names[], // list of implementations by name
                    const size_t n_impls,     // number of implementations available
                    const char* impl_name     // the implementation name to find
@@ -30,6 +36,21 @@ int volk_rank_archs(const char* kern_name,    // name of the kernel to rank
                     const bool align          // if false, filter aligned implementations
 );
 
+//! true if VOLK_GENERIC or VOLK_IMPL_<kernel> pins the implementations
+bool volk_rank_archs_overridden(const char* kern_name);
+
+/*
+ * Resolve the vector length buckets volk_config lists for a kernel.
+ * Bucket i serves every call with num_points >= buckets[i].min_points
+ * up to the next bucket. Returns the number of buckets written.
+ */
+size_t volk_rank_archs_buckets(const char* kern_name,    // name of the kernel to rank
+                               const char* impl_names[], // list of implementations
+                               size_t n_impls,           // number of implementations
+                               volk_len_bucket_t* buckets, // resolved buckets
+                               size_t max_buckets          // capacity of buckets
+);
+
 #ifdef __cplusplus
 }
 #endif
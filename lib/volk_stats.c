@@ -0,0 +1,153 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of VOLK
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <volk/volk_stats.h>
+
+#include "volk_stats_counters.h"
+
+VOLK_THREAD_LOCAL volk_stats_block_t* volk_stats_local = NULL;
+
+// every thread that ever called a kernel, newest first
+static volk_stats_block_t* volk_stats_blocks = NULL;
+
+static void volk_stats_dump_at_exit(void)
+{
+    const char* path = getenv("VOLK_STATS_DUMP");
+    if (!path) {
+        return;
+    }
+    if (path[0] == '\0' || strcmp(path, "-") == 0) {
+        volk_dump_stats(stderr);
+        return;
+    }
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        fprintf(stderr, "Volk warning: cannot write stats to %s\n", path);
+        return;
+    }
+    volk_dump_stats(file);
+    fclose(file);
+}
+
+volk_stats_block_t* volk_stats_attach(void)
+{
+    volk_stats_block_t* block = (volk_stats_block_t*)malloc(sizeof(volk_stats_block_t));
+    if (!block) {
+        return NULL;
+    }
+    block->counters = (volk_stats_counters_t*)calloc(volk_stats_n_kernels,
+                                                     sizeof(volk_stats_counters_t));
+    if (!block->counters) {
+        free(block);
+        return NULL;
+    }
+
+    // push onto the list of blocks, readers only ever walk it
+    volk_stats_block_t* head = volk_atomic_load_acquire(&volk_stats_blocks);
+    do {
+        block->next = head;
+        if (volk_atomic_cas_ptr(&volk_stats_blocks, head, block)) {
+            break;
+        }
+        head = volk_atomic_load_acquire(&volk_stats_blocks);
+    } while (true);
+    volk_stats_local = block;
+
+    // the thread that pushed the first block registers the dump
+    if (!head && getenv("VOLK_STATS_DUMP")) {
+        atexit(volk_stats_dump_at_exit);
+    }
+    return block;
+}
+
+size_t volk_get_stats(volk_kernel_stats_t* stats, size_t max_stats)
+{
+    size_t n_called = 0;
+    for (size_t kernel = 0; kernel < volk_stats_n_kernels; kernel++) {
+        volk_kernel_stats_t sum;
+        memset(&sum, 0, sizeof(sum));
+        sum.name = volk_stats_kernel_names[kernel];
+
+        volk_stats_block_t* block = volk_atomic_load_acquire(&volk_stats_blocks);
+        for (; block; block = block->next) {
+            volk_stats_counters_t* counters = &block->counters[kernel];
+            const uint64_t calls = volk_atomic_load_relaxed(&counters->calls);
+            if (calls == 0) {
+                continue;
+            }
+            sum.calls += calls;
+            sum.points += volk_atomic_load_relaxed(&counters->points);
+            sum.aligned_calls += volk_atomic_load_relaxed(&counters->aligned_calls);
+            sum.cycles += volk_atomic_load_relaxed(&counters->cycles);
+            for (size_t bin = 0; bin < VOLK_STATS_HIST_BINS; bin++) {
+                sum.hist[bin] += volk_atomic_load_relaxed(&counters->hist[bin]);
+            }
+        }
+        if (sum.calls == 0) {
+            continue;
+        }
+        // derived here, so calls and aligned_calls may be out of step by a call
+        sum.unaligned_calls =
+            sum.calls > sum.aligned_calls ? sum.calls - sum.aligned_calls : 0;
+        if (stats && n_called < max_stats) {
+            stats[n_called] = sum;
+        }
+        n_called++;
+    }
+    return n_called;
+}
+
+static int volk_stats_compare_cycles(const void* lhs, const void* rhs)
+{
+    const uint64_t a = ((const volk_kernel_stats_t*)lhs)->cycles;
+    const uint64_t b = ((const volk_kernel_stats_t*)rhs)->cycles;
+    return (a < b) - (a > b);
+}
+
+void volk_dump_stats(FILE* file)
+{
+    size_t n_stats = volk_get_stats(NULL, 0);
+    volk_kernel_stats_t* stats =
+        (volk_kernel_stats_t*)calloc(n_stats ? n_stats : 1, sizeof(volk_kernel_stats_t));
+    if (!stats) {
+        return;
+    }
+    // more kernels may have been called in between, only print the first ones
+    const size_t n_called = volk_get_stats(stats, n_stats);
+    n_stats = n_called < n_stats ? n_called : n_stats;
+    qsort(stats, n_stats, sizeof(volk_kernel_stats_t), volk_stats_compare_cycles);
+
+    fprintf(file, "#kernel calls points aligned unaligned cycles histogram\n");
+    for (size_t i = 0; i < n_stats; i++) {
+        const volk_kernel_stats_t* s = &stats[i];
+        fprintf(file,
+                "%s %llu %llu %llu %llu %llu",
+                s->name,
+                (unsigned long long)s->calls,
+                (unsigned long long)s->points,
+                (unsigned long long)s->aligned_calls,
+                (unsigned long long)s->unaligned_calls,
+                (unsigned long long)s->cycles);
+        // print the non empty bins as <smallest num_points>:<calls>
+        for (size_t bin = 0; bin < VOLK_STATS_HIST_BINS; bin++) {
+            if (s->hist[bin]) {
+                fprintf(file,
+                        " %llu:%llu",
+                        bin ? 1ULL << (bin - 1) : 0ULL,
+                        (unsigned long long)s->hist[bin]);
+            }
+        }
+        fprintf(file, "\n");
+    }
+    free(stats);
+}
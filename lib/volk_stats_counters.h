@@ -0,0 +1,92 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of VOLK
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef INCLUDED_VOLK_STATS_COUNTERS_H
+#define INCLUDED_VOLK_STATS_COUNTERS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <volk/volk_stats.h>
+
+#include "volk_atomic.h"
+#include "volk_ticks.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Counters of one kernel in one thread. Only the owning thread writes
+ * them, so relaxed loads and stores are enough; readers may see a count
+ * that is a few calls old but never a torn one.
+ */
+typedef struct volk_stats_counters {
+    uint64_t calls;
+    uint64_t points;
+    uint64_t aligned_calls;
+    uint64_t cycles;
+    uint64_t hist[VOLK_STATS_HIST_BINS];
+} volk_stats_counters_t;
+
+// the counters of all kernels for one thread, blocks are never freed
+typedef struct volk_stats_block {
+    struct volk_stats_block* next;
+    volk_stats_counters_t* counters;
+} volk_stats_block_t;
+
+// generated with the dispatch table in volk.c
+extern const char* const volk_stats_kernel_names[];
+extern const size_t volk_stats_n_kernels;
+
+extern VOLK_THREAD_LOCAL volk_stats_block_t* volk_stats_local;
+
+//! allocate and register the counters of the calling thread, NULL if out of memory
+volk_stats_block_t* volk_stats_attach(void);
+
+static inline unsigned int volk_stats_hist_bin(uint64_t points)
+{
+    if (points == 0) {
+        return 0;
+    }
+#if defined(__GNUC__) || defined(__clang__)
+    unsigned int bin = 64 - __builtin_clzll(points);
+#else
+    unsigned int bin = 0;
+    while (points) {
+        points >>= 1;
+        bin++;
+    }
+#endif
+    return bin < VOLK_STATS_HIST_BINS ? bin : VOLK_STATS_HIST_BINS - 1;
+}
+
+#define volk_stats_bump(ptr, val) \
+    volk_atomic_store_relaxed((ptr), volk_atomic_load_relaxed(ptr) + (val))
+
+static inline void
+volk_stats_record(size_t kernel, uint64_t points, bool aligned, uint64_t start)
+{
+    const uint64_t cycles = volk_ticks() - start;
+    volk_stats_block_t* block = volk_stats_local;
+    if (!block && !(block = volk_stats_attach())) {
+        return;
+    }
+    volk_stats_counters_t* counters = &block->counters[kernel];
+    volk_stats_bump(&counters->calls, 1);
+    volk_stats_bump(&counters->points, points);
+    volk_stats_bump(&counters->aligned_calls, aligned ? 1 : 0);
+    volk_stats_bump(&counters->cycles, cycles);
+    volk_stats_bump(&counters->hist[volk_stats_hist_bin(points)], 1);
+}
+
+#ifdef __cplusplus
+}
+#endif
+#endif /*INCLUDED_VOLK_STATS_COUNTERS_H*/
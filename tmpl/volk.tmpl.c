@@ -12,40 +12,101 @@
 #include <volk/volk_typedefs.h>
 #include <volk/volk_cpu.h>
 #include "volk_rank_archs.h"
+#include "volk_atomic.h"
 #include <volk/volk.h>
+#include <volk/volk_prefs.h>
+#ifdef VOLK_STATS
+#include "volk_stats_counters.h"
+#endif
+#ifdef VOLK_ADAPTIVE
+#include "volk_adaptive.h"
+#include "volk_ticks.h"
+#endif
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
 #include <assert.h>
 
 static size_t __alignment = 0;
 static intptr_t __alignment_mask = 0;
 
-struct volk_machine *get_machine(void)
+static struct volk_machine *__machine = NULL;
+static char __machine_selection[64] = "";
+
+static bool __machine_allowed(const struct volk_machine *machine, const char *selection)
+{
+  if(selection == NULL || selection[0] == '\0' || strcmp(selection, "max-caps") == 0)
+    return true;
+  if(strcmp(selection, "prefer-no-avx512") == 0)
+    return !(machine->caps & ((1 << LV_AVX512F) | (1 << LV_AVX512CD)));
+  // a full machine name, or its leading arch such as "avx2"
+  const size_t len = strlen(selection);
+  return strncmp(machine->name, selection, len) == 0 &&
+         (machine->name[len] == '\0' || machine->name[len] == '_');
+}
+
+// the most capable machine this CPU runs that the selection allows, or NULL
+static struct volk_machine *__select_machine(const char *selection)
 {
   extern struct volk_machine *volk_machines[];
   extern unsigned int n_volk_machines;
-  static struct volk_machine *machine = NULL;
 
-  if(machine != NULL)
-    return machine;
-  else {
-    unsigned int max_score = 0;
-    unsigned int i;
-    struct volk_machine *max_machine = NULL;
-    for(i=0; i<n_volk_machines; i++) {
-      if(!(volk_machines[i]->caps & (~volk_get_lvarch()))) {
-        if(volk_machines[i]->caps > max_score) {
-          max_score = volk_machines[i]->caps;
-          max_machine = volk_machines[i];
-        }
+  unsigned int max_score = 0;
+  unsigned int i;
+  struct volk_machine *max_machine = NULL;
+  for(i=0; i<n_volk_machines; i++) {
+    if(!(volk_machines[i]->caps & (~volk_get_lvarch())) &&
+       __machine_allowed(volk_machines[i], selection)) {
+      if(volk_machines[i]->caps > max_score) {
+        max_score = volk_machines[i]->caps;
+        max_machine = volk_machines[i];
       }
     }
-    machine = max_machine;
-    //printf("Using Volk machine: %s\n", machine->name);
-    __alignment = machine->alignment;
+  }
+  return max_machine;
+}
+
+struct volk_machine *get_machine(void)
+{
+  struct volk_machine *published = volk_atomic_load_acquire(&__machine);
+  if(published != NULL)
+    return published;
+  else {
+    const char *selection = __machine_selection[0] ? __machine_selection : getenv("VOLK_MACHINE");
+    struct volk_machine *max_machine = __select_machine(selection);
+    if(max_machine == NULL) {
+      fprintf(stderr, "Volk warning: no machine matches %s, using the default\n", selection);
+      max_machine = __select_machine(NULL);
+    }
+    //printf("Using Volk machine: %s\n", max_machine->name);
+    // every racing thread computes the same machine, so the alignment
+    // is identical as well; publish the machine last
+    __alignment = max_machine->alignment;
     __alignment_mask = (intptr_t)(__alignment-1);
-    return machine;
+    volk_atomic_store_release(&__machine, max_machine);
+    return max_machine;
+  }
+}
+
+bool volk_set_machine(const char *selection)
+{
+  if(selection == NULL)
+    selection = "";
+  if(volk_atomic_load_acquire(&__machine) != NULL) {
+#if defined(VOLK_EAGER_DISPATCH) && (defined(__GNUC__) || defined(__clang__))
+    // the load time dispatch below has already fixed the machine
+    fprintf(stderr, "Volk error: volk_set_machine is not supported with "
+                    "ENABLE_EAGER_DISPATCH, use VOLK_MACHINE instead\n");
+#endif
+    return false;
   }
+  if(strlen(selection) >= sizeof(__machine_selection))
+    return false;
+  if(selection[0] != '\0' && __select_machine(selection) == NULL)
+    return false;
+  strcpy(__machine_selection, selection);
+  return true;
 }
 
 void volk_list_machines(void)
@@ -64,27 +125,53 @@ void volk_list_machines(void)
 
 const char* volk_get_machine(void)
 {
-  extern struct volk_machine *volk_machines[];
-  extern unsigned int n_volk_machines;
-  static struct volk_machine *machine = NULL;
+  return get_machine()->name;
+}
 
-  if(machine != NULL)
-    return machine->name;
-  else {
-    unsigned int max_score = 0;
-    unsigned int i;
-    struct volk_machine *max_machine = NULL;
-    for(i=0; i<n_volk_machines; i++) {
-      if(!(volk_machines[i]->caps & (~volk_get_lvarch()))) {
-        if(volk_machines[i]->caps > max_score) {
-          max_score = volk_machines[i]->caps;
-          max_machine = volk_machines[i];
-        }
-      }
-    }
-    machine = max_machine;
-    return machine->name;
+const char* volk_get_cpu_fingerprint(void)
+{
+  static char *fingerprint = NULL;
+
+  char *published = volk_atomic_load_acquire(&fingerprint);
+  if(published != NULL)
+    return published;
+
+  char cpu[128];
+  volk_cpu_fingerprint(cpu, sizeof(cpu));
+  const char *machine = volk_get_machine();
+  const size_t len = strlen(cpu) + strlen(machine) + 2;
+  char *fp = (char *)malloc(len);
+  if(fp == NULL)
+    return "unknown";
+  snprintf(fp, len, "%s-%s", cpu, machine);
+  // keep the fingerprint usable as a single config token
+  for(char *c = fp; *c; c++) {
+    if(!isalnum((unsigned char)*c) && *c != '-' && *c != '_' && *c != '.')
+      *c = '_';
   }
+  if(!volk_atomic_cas_ptr(&fingerprint, (char *)NULL, fp))
+    free(fp);
+  return volk_atomic_load_acquire(&fingerprint);
+}
+
+void volk_get_cache_sizes(size_t *l1, size_t *l2, size_t *llc)
+{
+  volk_cpu_cache_sizes(l1, l2, llc);
+}
+
+bool volk_can_flush_denormals(void)
+{
+  return volk_cpu_can_flush_denormals();
+}
+
+volk_denormal_mode_t volk_flush_denormals(bool enable)
+{
+  return volk_cpu_flush_denormals(enable);
+}
+
+void volk_restore_denormals(volk_denormal_mode_t mode)
+{
+  volk_cpu_restore_denormals(mode);
 }
 
 size_t volk_get_alignment(void)
@@ -98,6 +185,55 @@ bool volk_is_aligned(const void *ptr)
     return ((intptr_t)(ptr) & __alignment_mask) == 0;
 }
 
+// exact match of an implementation name, -1 when the machine lacks it
+static int __volk_find_impl(const char **impl_names, size_t n_impls, const char *impl_name)
+{
+    for (size_t i = 0; i < n_impls; i++) {
+        if (strcmp(impl_names[i], impl_name) == 0)
+            return (int)i;
+    }
+    return -1;
+}
+
+// the implementation whose padded twin impl_name names, -1 when it is none
+static int __volk_find_padded(const char **impl_names, size_t n_impls, const char *impl_name)
+{
+    static const char suffix[] = "_padded";
+    const size_t len = strlen(impl_name);
+    const size_t base_len = len - (sizeof(suffix) - 1);
+    if (len < sizeof(suffix) || strcmp(impl_name + base_len, suffix) != 0)
+        return -1;
+    for (size_t i = 0; i < n_impls; i++) {
+        if (strlen(impl_names[i]) == base_len && strncmp(impl_names[i], impl_name, base_len) == 0)
+            return (int)i;
+    }
+    return -1;
+}
+
+#ifdef VOLK_PEEL_DISPATCH
+/*
+ * Number of elements of elem_size bytes from ptr to the next alignment
+ * boundary, or (size_t)-1 when no whole number of elements ends there.
+ */
+static inline size_t __volk_peel_head(const void *ptr, size_t elem_size)
+{
+    const size_t misalignment = (size_t)((intptr_t)ptr & __alignment_mask);
+    if (misalignment == 0)
+        return 0;
+    const size_t gap = __alignment - misalignment;
+    return (gap % elem_size) ? (size_t)-1 : gap / elem_size;
+}
+#endif
+
+<%def name="all_aligned(kern, offset='')">volk_is_aligned(<% num_open_parens = 0 %>
+    %for arg_type, arg_name in kern.args:
+        %if '*' in arg_type:
+        VOLK_OR_PTR(${arg_name}${offset},<% num_open_parens += 1 %>
+        %endif
+    %endfor
+        0<% end_open_parens = ')'*num_open_parens %>${end_open_parens}
+    )</%def>
+
 #define LV_HAVE_GENERIC
 #define LV_HAVE_DISPATCHER
 
@@ -107,28 +243,148 @@ bool volk_is_aligned(const void *ptr)
 #include <volk/${kern.name}.h> //pulls in the dispatcher
 %endif
 
-static inline void __${kern.name}_d(${kern.arglist_full})
+%if kern.len_arg:
+// the length buckets of volk_config, never changed once published
+struct __${kern.name}_buckets {
+    size_t n_buckets;
+    struct {
+        unsigned int min_points;
+        ${kern.pname} impl_a;
+        ${kern.pname} impl_u;
+    } buckets[VOLK_MAX_LEN_BUCKETS];
+};
+static struct __${kern.name}_buckets *__${kern.name}_bucket_table = NULL;
+// the table above while it is in effect, NULL under volk_set_impl
+static struct __${kern.name}_buckets *__${kern.name}_buckets_active = NULL;
+%endif
+
+// set while volk_set_impl pins the kernel, volk_init_dispatch leaves it alone
+static int __${kern.name}_overridden = 0;
+
+%if kern.len_arg and not kern.has_dispatcher:
+#ifdef VOLK_ADAPTIVE
+static volk_adaptive_t *__${kern.name}_adaptive = NULL;
+// the state above while tuning is in effect, NULL under volk_set_impl
+static volk_adaptive_t *__${kern.name}_adaptive_active = NULL;
+
+static inline void __${kern.name}_tuned(volk_adaptive_t *adaptive, ${kern.arglist_full})
+{
+    const bool aligned = ${all_aligned(kern)};
+    uint32_t trial;
+    const size_t index = volk_adaptive_select(adaptive, ${kern.len_arg}, aligned, &trial);
+    const ${kern.pname} impl = get_machine()->${kern.name}_impls[index];
+    if (trial == VOLK_ADAPTIVE_NO_TRIAL) {
+        impl(${kern.arglist_names});
+        return;
+    }
+    const uint64_t start = volk_ticks();
+    impl(${kern.arglist_names});
+    volk_adaptive_record(adaptive, ${kern.len_arg}, aligned, trial, volk_ticks() - start);
+}
+#endif
+%endif
+
+static inline void __${kern.name}_dispatch(${kern.arglist_full})
 {
     %if kern.has_dispatcher:
     ${kern.name}_dispatcher(${kern.arglist_names});
     return;
+    %elif kern.len_arg:
+#ifdef VOLK_ADAPTIVE
+    volk_adaptive_t *adaptive = volk_atomic_load_acquire(&__${kern.name}_adaptive_active);
+    if (adaptive != NULL) {
+        __${kern.name}_tuned(adaptive, ${kern.arglist_names});
+        return;
+    }
+#endif
     %endif
 
-    if (volk_is_aligned(<% num_open_parens = 0 %>
-    %for arg_type, arg_name in kern.args:
-        %if '*' in arg_type:
-        VOLK_OR_PTR(${arg_name},<% num_open_parens += 1 %>
-        %endif
-    %endfor
-        0<% end_open_parens = ')'*num_open_parens %>${end_open_parens}
-    )){
-        ${kern.name}_a(${kern.arglist_names});
+    ${kern.pname} impl_a = ${kern.name}_a;
+    ${kern.pname} impl_u = ${kern.name}_u;
+    %if kern.len_arg:
+    // pick the implementations of the largest bucket this call fits into
+    const struct __${kern.name}_buckets *table = volk_atomic_load_acquire(&__${kern.name}_buckets_active);
+    size_t bucket = table != NULL ? table->n_buckets : 0;
+    while (bucket-- > 0) {
+        if (${kern.len_arg} >= table->buckets[bucket].min_points) {
+            impl_a = table->buckets[bucket].impl_a;
+            impl_u = table->buckets[bucket].impl_u;
+            break;
+        }
+    }
+    %endif
+
+    if (${all_aligned(kern)}){
+        impl_a(${kern.arglist_names});
     }
     else{
-        ${kern.name}_u(${kern.arglist_names});
+    %if kern.splittable:
+<%
+ptr_names = [name for arg_type, name in kern.args if '*' in arg_type]
+head_args = ', '.join(['head' if name == kern.len_arg else name for arg_type, name in kern.args])
+bulk_args = ', '.join([name + ' + head' if '*' in arg_type else
+                       name + ' - head' if name == kern.len_arg else name
+                       for arg_type, name in kern.args])
+%>
+#ifdef VOLK_PEEL_DISPATCH
+        // when all buffers share the same misalignment, run the unaligned
+        // implementation up to the boundary and the aligned one on the rest
+        const size_t head = __volk_peel_head(${ptr_names[0]}, sizeof(*${ptr_names[0]}));
+        if (impl_a != impl_u && head < ${kern.len_arg} && ${all_aligned(kern, ' + head')}){
+            if (head > 0)
+                impl_u(${head_args});
+            impl_a(${bulk_args});
+            return;
+        }
+#endif
+    %endif
+        impl_u(${kern.arglist_names});
     }
 }
 
+static void __${kern.name}_d(${kern.arglist_full})
+{
+#ifdef VOLK_STATS
+    const uint64_t stats_start = volk_ticks();
+    __${kern.name}_dispatch(${kern.arglist_names});
+    const bool stats_aligned = ${all_aligned(kern)};
+    volk_stats_record(${loop.index}, ${kern.len_arg or 0}, stats_aligned, stats_start);
+#else
+    __${kern.name}_dispatch(${kern.arglist_names});
+#endif
+}
+
+%if kern.has_padded:
+static ${kern.pname} __${kern.name}_padded_a = NULL;
+static ${kern.pname} __${kern.name}_padded_u = NULL;
+
+// point the padded dispatcher at the twins of the chosen implementations
+static inline void __${kern.name}_set_padded(size_t index_a, size_t index_u)
+{
+    const ${kern.pname} *impls = get_machine()->${kern.name}_impls;
+    const ${kern.pname} *padded = get_machine()->${kern.name}_impl_padded;
+    volk_atomic_store_release(&__${kern.name}_padded_a, padded[index_a] ? padded[index_a] : impls[index_a]);
+    volk_atomic_store_release(&__${kern.name}_padded_u, padded[index_u] ? padded[index_u] : impls[index_u]);
+}
+
+// the caller guarantees VOLK_PADDING bytes of slack after every buffer;
+// length buckets and adaptive selection do not apply here
+static void __${kern.name}_padded_d(${kern.arglist_full})
+{
+#ifdef VOLK_STATS
+    const uint64_t stats_start = volk_ticks();
+#endif
+    const bool aligned = ${all_aligned(kern)};
+    if (aligned)
+        volk_atomic_load_acquire(&__${kern.name}_padded_a)(${kern.arglist_names});
+    else
+        volk_atomic_load_acquire(&__${kern.name}_padded_u)(${kern.arglist_names});
+#ifdef VOLK_STATS
+    volk_stats_record(${loop.index}, ${kern.len_arg or 0}, aligned, stats_start);
+#endif
+}
+%endif
+
 static inline void __init_${kern.name}(void)
 {
     const char *name = get_machine()->${kern.name}_name;
@@ -138,13 +394,105 @@ static inline void __init_${kern.name}(void)
     const size_t n_impls = get_machine()->${kern.name}_n_impls;
     const size_t index_a = volk_rank_archs(name, impl_names, impl_deps, alignment, n_impls, true/*aligned*/);
     const size_t index_u = volk_rank_archs(name, impl_names, impl_deps, alignment, n_impls, false/*unaligned*/);
-    ${kern.name}_a = get_machine()->${kern.name}_impls[index_a];
-    ${kern.name}_u = get_machine()->${kern.name}_impls[index_u];
+    const ${kern.pname} impl_a = get_machine()->${kern.name}_impls[index_a];
+    const ${kern.pname} impl_u = get_machine()->${kern.name}_impls[index_u];
 
-    assert(${kern.name}_a);
-    assert(${kern.name}_u);
+    assert(impl_a);
+    assert(impl_u);
 
-    ${kern.name} = &__${kern.name}_d;
+    %if kern.len_arg:
+    // the table is filled once and published whole, dispatchers on other
+    // threads may be reading it
+    struct __${kern.name}_buckets *table = volk_atomic_load_acquire(&__${kern.name}_bucket_table);
+    if (table == NULL) {
+        volk_len_bucket_t buckets[VOLK_MAX_LEN_BUCKETS];
+        const size_t n_buckets = volk_rank_archs_buckets(name, impl_names, n_impls, buckets, VOLK_MAX_LEN_BUCKETS);
+        if (n_buckets > 0)
+            table = (struct __${kern.name}_buckets *)malloc(sizeof(*table));
+        if (table != NULL) {
+            table->n_buckets = n_buckets;
+            for (size_t i = 0; i < n_buckets; i++) {
+                table->buckets[i].min_points = buckets[i].min_points;
+                table->buckets[i].impl_a = get_machine()->${kern.name}_impls[buckets[i].index_a];
+                table->buckets[i].impl_u = get_machine()->${kern.name}_impls[buckets[i].index_u];
+            }
+            if (!volk_atomic_cas_ptr(&__${kern.name}_bucket_table, (struct __${kern.name}_buckets *)NULL, table)) {
+                free(table);
+                table = volk_atomic_load_acquire(&__${kern.name}_bucket_table);
+            }
+        }
+    }
+    volk_atomic_store_release(&__${kern.name}_buckets_active, table);
+    %endif
+
+    %if kern.len_arg and not kern.has_dispatcher:
+#ifdef VOLK_ADAPTIVE
+    volk_adaptive_t *adaptive = volk_atomic_load_acquire(&__${kern.name}_adaptive);
+    if (adaptive == NULL) {
+        adaptive = volk_adaptive_create(name, impl_names, alignment, n_impls, index_a, index_u);
+        if (adaptive != NULL)
+            adaptive = volk_adaptive_publish(&__${kern.name}_adaptive, adaptive);
+    }
+    volk_atomic_store_release(&__${kern.name}_adaptive_active, adaptive);
+#endif
+    %endif
+
+    %if kern.has_padded:
+    __${kern.name}_set_padded(index_a, index_u);
+    volk_atomic_store_release(&${kern.name}_padded, &__${kern.name}_padded_d);
+    %endif
+    // publish the dispatcher last, a thread that sees it also sees its table
+    volk_atomic_store_release(&${kern.name}_a, impl_a);
+    volk_atomic_store_release(&${kern.name}_u, impl_u);
+    volk_atomic_store_release(&${kern.name}, &__${kern.name}_d);
+}
+
+static bool __set_impl_${kern.name}(const char *impl_a_name, const char *impl_u_name)
+{
+    if (impl_a_name == NULL) {
+        volk_atomic_store_release(&__${kern.name}_overridden, 0);
+        __init_${kern.name}(); // back to the ranked implementations
+        return true;
+    }
+
+    // nothing is stored unless both names are valid, a bad override keeps
+    // the implementations in use
+    const char **impl_names = get_machine()->${kern.name}_impl_names;
+    const bool *alignment = get_machine()->${kern.name}_impl_alignment;
+    const size_t n_impls = get_machine()->${kern.name}_n_impls;
+    const int index_a = __volk_find_impl(impl_names, n_impls, impl_a_name);
+    if (index_a < 0)
+        return false;
+    int index_u = index_a;
+    if (impl_u_name != NULL) {
+        index_u = __volk_find_impl(impl_names, n_impls, impl_u_name);
+        if (index_u < 0 || alignment[index_u])
+            return false;
+    } else if (alignment[index_a]) {
+        // like a single name in VOLK_IMPL_<kernel>, an aligned only
+        // implementation leaves unaligned calls to the ranked one
+        const int *impl_deps = get_machine()->${kern.name}_impl_deps;
+        index_u = (int)volk_rank_archs(get_machine()->${kern.name}_name, impl_names, impl_deps, alignment, n_impls, false/*unaligned*/);
+    }
+
+    volk_atomic_store_release(&__${kern.name}_overridden, 1);
+    %if kern.len_arg:
+    // an override applies to every vector length
+    volk_atomic_store_release(&__${kern.name}_buckets_active, (struct __${kern.name}_buckets *)NULL);
+    %endif
+    %if kern.len_arg and not kern.has_dispatcher:
+#ifdef VOLK_ADAPTIVE
+    volk_atomic_store_release(&__${kern.name}_adaptive_active, (volk_adaptive_t *)NULL);
+#endif
+    %endif
+    %if kern.has_padded:
+    __${kern.name}_set_padded(index_a, index_u);
+    volk_atomic_store_release(&${kern.name}_padded, &__${kern.name}_padded_d);
+    %endif
+    volk_atomic_store_release(&${kern.name}_a, get_machine()->${kern.name}_impls[index_a]);
+    volk_atomic_store_release(&${kern.name}_u, get_machine()->${kern.name}_impls[index_u]);
+    volk_atomic_store_release(&${kern.name}, &__${kern.name}_d);
+    return true;
 }
 
 static inline void __${kern.name}_a(${kern.arglist_full})
@@ -169,8 +517,40 @@ ${kern.pname} ${kern.name}_a = &__${kern.name}_a;
 ${kern.pname} ${kern.name}_u = &__${kern.name}_u;
 ${kern.pname} ${kern.name}   = &__${kern.name};
 
+%if kern.has_padded:
+static inline void __${kern.name}_padded(${kern.arglist_full})
+{
+    __init_${kern.name}();
+    ${kern.name}_padded(${kern.arglist_names});
+}
+
+${kern.pname} ${kern.name}_padded = &__${kern.name}_padded;
+
+static bool __has_padded_${kern.name}(const char *impl_name)
+{
+    const int index = __volk_find_impl(get_machine()->${kern.name}_impl_names,
+                                       get_machine()->${kern.name}_n_impls,
+                                       impl_name);
+    return index >= 0 && get_machine()->${kern.name}_impl_padded[index] != NULL;
+}
+
+%endif
 void ${kern.name}_manual(${kern.arglist_full}, const char* impl_name)
 {
+    %if kern.has_padded:
+    // "a_avx_padded" calls the padded twin of a_avx
+    const int padded = __volk_find_padded(
+        get_machine()->${kern.name}_impl_names,
+        get_machine()->${kern.name}_n_impls,
+        impl_name
+    );
+    if (padded >= 0 && get_machine()->${kern.name}_impl_padded[padded] != NULL) {
+        get_machine()->${kern.name}_impl_padded[padded](
+            ${kern.arglist_names}
+        );
+        return;
+    }
+    %endif
     const int index = volk_get_index(
         get_machine()->${kern.name}_impl_names,
         get_machine()->${kern.name}_n_impls,
@@ -196,3 +576,70 @@ volk_func_desc_t ${kern.name}_get_func_desc(void) {
 }
 
 %endfor
+
+const char* const volk_stats_kernel_names[] = {
+%for kern in kernels:
+    "${kern.name}",
+%endfor
+};
+const size_t volk_stats_n_kernels = ${len(kernels)};
+
+static const struct {
+    const char *name;
+    bool (*set_impl)(const char *, const char *);
+} __volk_set_impl_table[] = {
+%for kern in kernels:
+    {"${kern.name}", &__set_impl_${kern.name}},
+%endfor
+};
+
+bool volk_set_impl(const char *kernel, const char *impl_a, const char *impl_u)
+{
+    if (kernel == NULL)
+        return false;
+    const size_t n_kernels = sizeof(__volk_set_impl_table) / sizeof(__volk_set_impl_table[0]);
+    for (size_t i = 0; i < n_kernels; i++) {
+        if (strcmp(__volk_set_impl_table[i].name, kernel) == 0)
+            return __volk_set_impl_table[i].set_impl(impl_a, impl_u);
+    }
+    return false;
+}
+
+static const struct {
+    const char *name;
+    bool (*has_padded)(const char *);
+} __volk_padded_table[] = {
+%for kern in kernels:
+%if kern.has_padded:
+    {"${kern.name}", &__has_padded_${kern.name}},
+%endif
+%endfor
+    {NULL, NULL}
+};
+
+bool volk_has_padded_impl(const char *kernel, const char *impl)
+{
+    if (kernel == NULL || impl == NULL)
+        return false;
+    for (size_t i = 0; __volk_padded_table[i].name != NULL; i++) {
+        if (strcmp(__volk_padded_table[i].name, kernel) == 0)
+            return __volk_padded_table[i].has_padded(impl);
+    }
+    return false;
+}
+
+void volk_init_dispatch(void)
+{
+%for kern in kernels:
+    if (!volk_atomic_load_acquire(&__${kern.name}_overridden))
+        __init_${kern.name}();
+%endfor
+}
+
+#if defined(VOLK_EAGER_DISPATCH) && (defined(__GNUC__) || defined(__clang__))
+// resolve the whole dispatch table while the library is being loaded
+__attribute__((constructor)) static void __volk_eager_dispatch(void)
+{
+    volk_init_dispatch();
+}
+#endif
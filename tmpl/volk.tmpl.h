@@ -36,9 +36,125 @@ VOLK_API void volk_list_machines(void);
 //! Returns the name of the machine this instance will use
 VOLK_API const char* volk_get_machine(void);
 
+/*!
+ * Choose the machine by name or by policy.
+ *
+ * By default VOLK uses the most capable machine the CPU supports. The
+ * selection may instead name a machine as printed by volk_list_machines,
+ * e.g. "avx2_64_mmx", or just its leading arch, e.g. "avx2". It may also
+ * be a policy: "max-caps" is the default, "prefer-no-avx512" skips the
+ * AVX-512 machines whose frequency license can slow down the rest of the
+ * process. The environment variable VOLK_MACHINE takes the same values
+ * and is used when this function was not called.
+ *
+ * The machine is fixed by the first kernel call or other VOLK call that
+ * needs it, so call this first, before any other thread uses VOLK.
+ * Libraries built with ENABLE_EAGER_DISPATCH fix it while they are
+ * loaded, so there this always fails with an error message and only
+ * VOLK_MACHINE selects the machine.
+ *
+ * \param selection machine name or policy, NULL or "" for the default
+ * \return false if the machine is already fixed or nothing matches
+ */
+VOLK_API bool volk_set_machine(const char* selection);
+
 //! Get the machine alignment in bytes
 VOLK_API size_t volk_get_alignment(void);
 
+/*!
+ * Identifies this host for volk_config, e.g. "GenuineIntel-6-85-avx512f_64_mmx".
+ *
+ * The fingerprint combines the CPU vendor, family and model reported by
+ * cpu_features with the name of the VOLK machine in use. volk_config
+ * sections titled [fingerprint] only apply to hosts that match it.
+ */
+VOLK_API const char* volk_get_cpu_fingerprint(void);
+
+/*!
+ * Data cache sizes of the host in bytes: L1, L2 and the last level cache.
+ * Sizes that cpu_features or the OS do not report are 0.
+ */
+VOLK_API void volk_get_cache_sizes(size_t* l1, size_t* l2, size_t* llc);
+
+//! The denormal handling state of a thread, see volk_flush_denormals
+typedef unsigned long long volk_denormal_mode_t;
+
+//! Can volk_flush_denormals change the denormal handling on this platform?
+VOLK_API bool volk_can_flush_denormals(void);
+
+/*!
+ * Flush denormal floats to zero in the calling thread.
+ *
+ * Sets flush-to-zero and denormals-are-zero in MXCSR on x86, or FZ in
+ * FPCR on aarch64. Kernels then neither produce denormal results nor
+ * read denormal inputs as anything but zero, and avoid the microcode
+ * assists that slow them down by an order of magnitude on such data,
+ * e.g. on the decaying tail of a feedback path. Other threads keep
+ * their own setting. Does nothing where volk_can_flush_denormals is
+ * false. C++ code can use the volk::flush_denormals guard from
+ * volk/volk_denormals.hh instead.
+ *
+ * \param enable true to flush, false for IEEE 754 denormal handling
+ * \return the previous state, for volk_restore_denormals
+ */
+VOLK_API volk_denormal_mode_t volk_flush_denormals(bool enable);
+
+//! Put back the denormal handling returned by volk_flush_denormals
+VOLK_API void volk_restore_denormals(volk_denormal_mode_t mode);
+
+/*!
+ * Resolve the dispatch pointers of every kernel now.
+ *
+ * By default each kernel resolves its implementation on its first call.
+ * Calling this once, e.g. before worker threads start, moves that cost
+ * out of the processing path. Libraries built with ENABLE_EAGER_DISPATCH
+ * do this automatically when they are loaded. It is safe to call from
+ * several threads. Kernels bound by volk_set_impl keep that binding.
+ */
+VOLK_API void volk_init_dispatch(void);
+
+/*!
+ * Bind a kernel to the named implementations at runtime.
+ *
+ * Rebinds the kernel's dispatcher and its _a and _u pointers, e.g.
+ * volk_set_impl("volk_32fc_x2_multiply_32fc", "a_avx2_fma", "u_avx2_fma").
+ * The override beats volk_config and applies to every vector length.
+ * Each pointer is swapped atomically, so concurrent callers keep working
+ * and pick up the new implementation with their next call.
+ *
+ * The same override can be given before startup through the environment,
+ * e.g. VOLK_IMPL_volk_32fc_x2_multiply_32fc="a_avx2_fma u_avx2_fma".
+ *
+ * \param kernel the kernel name, e.g. "volk_32fc_x2_multiply_32fc"
+ * \param impl_a implementation for aligned buffers, NULL restores the
+ *        implementations selected by volk_config and the environment
+ * \param impl_u implementation for unaligned buffers, NULL to use impl_a;
+ *        if impl_a requires alignment, unaligned calls then keep the
+ *        implementation selected by volk_config, as with a single name
+ *        in VOLK_IMPL_<kernel>
+ * \return false if the kernel is unknown, an implementation is not
+ *         available on this machine, or impl_u requires alignment; the
+ *         kernel then keeps its current implementations
+ */
+VOLK_API bool volk_set_impl(const char* kernel, const char* impl_a, const char* impl_u);
+
+/*!
+ * Does the implementation have a padded twin on this machine?
+ *
+ * Kernels that support padded buffers have a _padded dispatch pointer,
+ * e.g. volk_32f_x2_add_32f_padded, with the arguments of the regular
+ * one. All its buffers must be followed by VOLK_PADDING bytes that it may
+ * read and overwrite, as allocated with VOLK_MALLOC_PADDED. It then runs
+ * full vector variants without a scalar tail where the kernel has them,
+ * named like the implementation they replace with a "_padded" suffix,
+ * e.g. "a_avx_padded" for "a_avx"; _manual accepts these names as well.
+ *
+ * \param kernel the kernel name, e.g. "volk_32f_x2_add_32f"
+ * \param impl the regular implementation, e.g. "a_avx"
+ * \return true if the _padded pointer runs a twin in place of \p impl
+ */
+VOLK_API bool volk_has_padded_impl(const char* kernel, const char* impl);
+
 /*!
  * The VOLK_OR_PTR macro is a convenience macro
  * for checking the alignment of a set of pointers.
@@ -63,16 +179,12 @@ VOLK_API bool volk_is_aligned(const void *ptr);
 // Just drop the deprecated attribute in case we are on Windows. Clang and GCC support `__attribute__`.
 // We just assume the compiler and the system are tight together as far as Mako templates are concerned.
 <%
-deprecated_kernels = ('volk_16i_x5_add_quad_16i_x4', 'volk_16i_branch_4_state_8', 
-                      'volk_16i_max_star_16i', 'volk_16i_max_star_horizontal_16i', 
-                      'volk_16i_permute_and_scalar_add', 'volk_16i_x4_quad_max_star_16i')
 from platform import system
-if system() == 'Windows':
-    deprecated_kernels = ()
+mark_deprecated = system() != 'Windows'
 %>
 %for kern in kernels:
 
-% if kern.name in deprecated_kernels:
+% if kern.deprecated and mark_deprecated:
 //! A function pointer to the dispatcher implementation
 extern VOLK_API ${kern.pname} ${kern.name} __attribute__((deprecated));
 
@@ -103,6 +215,11 @@ extern VOLK_API void ${kern.name}_manual(${kern.arglist_full}, const char* impl_
 //! Get description parameters for this kernel
 extern VOLK_API volk_func_desc_t ${kern.name}_get_func_desc(void);
 % endif
+% if kern.has_padded:
+
+//! A function pointer to the dispatcher for buffers padded by VOLK_PADDING bytes
+extern VOLK_API ${kern.pname} ${kern.name}_padded;
+% endif
 
 %endfor
 
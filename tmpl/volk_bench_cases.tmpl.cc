@@ -0,0 +1,66 @@
+/* -*- c++ -*- */
+/*
+ * Copyright 2026 Free Software Foundation, Inc.
+ *
+ * This file is part of VOLK
+ *
+ * SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include <volk/volk.h>
+
+#include "volk_bench.h"
+
+<%
+def element_type(arg_type):
+    return arg_type.replace('const', '').replace('*', '').strip()
+
+def skip_reason(kern):
+    if kern.deprecated:
+        return 'deprecated'
+    if kern.len_arg is None:
+        return 'no num_points argument'
+    return 'pointer to pointer argument'
+%>
+namespace {
+%for kern in kernels:
+%if kern.benchmarkable:
+
+volk_bench_call_t bind_${kern.name}(volk_bench_args& args, unsigned int num_points)
+{
+%for arg_type, arg_name in kern.args:
+%if arg_name == kern.len_arg:
+%elif '*' in arg_type:
+    auto ${arg_name} = args.vector<${element_type(arg_type)}>();
+%else:
+    auto ${arg_name} = args.scalar<${element_type(arg_type)}>();
+%endif
+%endfor
+    return [=](const char* impl_name) {
+        if (impl_name) {
+            ${kern.name}_manual(${kern.arglist_names}, impl_name);
+        } else {
+            ${kern.name}(${kern.arglist_names});
+        }
+    };
+}
+%endif
+%endfor
+
+} // namespace
+
+const std::vector<volk_bench_case_t> volk_bench_cases = {
+%for kern in kernels:
+%if kern.benchmarkable:
+    { "${kern.name}", ${kern.name}_get_func_desc, bind_${kern.name} },
+%endif
+%endfor
+};
+
+const std::vector<std::pair<const char*, const char*>> volk_bench_skipped = {
+%for kern in kernels:
+%if not kern.benchmarkable:
+    { "${kern.name}", "${skip_reason(kern)}" },
+%endif
+%endfor
+};
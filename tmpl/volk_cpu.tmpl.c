@@ -9,8 +9,12 @@
 
 #include <volk/volk_cpu.h>
 #include <volk/volk_config_fixed.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
 
 
 #if defined(VOLK_CPU_FEATURES)
@@ -88,6 +92,36 @@ static int i_can_has_${arch.name} (void) {
     }
 #endif
 
+// the flush-to-zero and denormals-are-zero bits of the float control register
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #include <xmmintrin.h>
+    #define DENORMAL_BITS 0x8040ULL // MXCSR FTZ (bit 15) and DAZ (bit 6)
+    static inline unsigned long long get_float_control(void){
+        return _mm_getcsr();
+    }
+    static inline void set_float_control(unsigned long long control){
+        _mm_setcsr((unsigned int)control);
+    }
+#elif defined(__aarch64__) && defined(__GNUC__)
+    #define DENORMAL_BITS (1ULL << 24) // FPCR FZ, flushes inputs and results
+    static inline unsigned long long get_float_control(void){
+        unsigned long long fpcr;
+        __asm__ __volatile__("mrs %0, fpcr" : "=r"(fpcr));
+        return fpcr;
+    }
+    static inline void set_float_control(unsigned long long fpcr){
+        __asm__ __volatile__("msr fpcr, %0" : : "r"(fpcr));
+    }
+#else
+    #define DENORMAL_BITS 0ULL
+    static inline unsigned long long get_float_control(void){
+        return 0;
+    }
+    static inline void set_float_control(unsigned long long control){
+        (void)control; //do nothing
+    }
+#endif
+
 
 void volk_cpu_init() {
     %for arch in archs:
@@ -96,6 +130,68 @@ void volk_cpu_init() {
     set_float_rounding();
 }
 
+int volk_cpu_can_flush_denormals(void) {
+    return DENORMAL_BITS != 0;
+}
+
+unsigned long long volk_cpu_flush_denormals(int enable) {
+    const unsigned long long control = get_float_control();
+    if (DENORMAL_BITS) {
+        set_float_control(enable ? control | DENORMAL_BITS : control & ~DENORMAL_BITS);
+    }
+    return control & DENORMAL_BITS;
+}
+
+void volk_cpu_restore_denormals(unsigned long long mode) {
+    if (DENORMAL_BITS) {
+        set_float_control((get_float_control() & ~DENORMAL_BITS) | (mode & DENORMAL_BITS));
+    }
+}
+
+void volk_cpu_fingerprint(char* buf, size_t len) {
+#if defined(VOLK_CPU_FEATURES) && defined(CPU_FEATURES_ARCH_X86)
+    const X86Info info = GetX86Info();
+    snprintf(buf, len, "%s-%d-%d", info.vendor, info.family, info.model);
+#elif defined(VOLK_CPU_FEATURES) && defined(CPU_FEATURES_ARCH_ARM)
+    const ArmInfo info = GetArmInfo();
+    snprintf(buf, len, "arm-%d-%d-%d", info.implementer, info.architecture, info.part);
+#elif defined(VOLK_CPU_FEATURES) && defined(CPU_FEATURES_ARCH_AARCH64)
+    const Aarch64Info info = GetAarch64Info();
+    snprintf(buf, len, "aarch64-%d-%d", info.implementer, info.part);
+#else
+    snprintf(buf, len, "unknown");
+#endif
+}
+
+void volk_cpu_cache_sizes(size_t* l1, size_t* l2, size_t* llc) {
+    *l1 = *l2 = *llc = 0;
+#if defined(VOLK_CPU_FEATURES) && defined(CPU_FEATURES_ARCH_X86)
+    const CacheInfo info = GetX86CacheInfo();
+    int llc_level = 0;
+    for (int i = 0; i < info.size; i++) {
+        const CacheLevelInfo* level = &info.levels[i];
+        if (level->cache_type != CPU_FEATURE_CACHE_DATA &&
+            level->cache_type != CPU_FEATURE_CACHE_UNIFIED)
+            continue;
+        if (level->level == 1)
+            *l1 = level->cache_size;
+        else if (level->level == 2)
+            *l2 = level->cache_size;
+        if (level->level >= llc_level) {
+            llc_level = level->level;
+            *llc = level->cache_size;
+        }
+    }
+#elif defined(_SC_LEVEL1_DCACHE_SIZE)
+    const long l1_size = sysconf(_SC_LEVEL1_DCACHE_SIZE);
+    const long l2_size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    const long l3_size = sysconf(_SC_LEVEL3_CACHE_SIZE);
+    *l1 = l1_size > 0 ? l1_size : 0;
+    *l2 = l2_size > 0 ? l2_size : 0;
+    *llc = l3_size > 0 ? (size_t)l3_size : *l2;
+#endif
+}
+
 unsigned int volk_get_lvarch() {
     unsigned int retval = 0;
     volk_cpu_init();
@@ -11,6 +11,7 @@
 #define INCLUDED_VOLK_CPU_H
 
 #include <volk/volk_common.h>
+#include <stddef.h>
 
 __VOLK_DECL_BEGIN
 
@@ -24,6 +25,16 @@ extern struct VOLK_CPU volk_cpu;
 
 void volk_cpu_init ();
 unsigned int volk_get_lvarch ();
+// vendor, family and model of the host CPU as far as cpu_features knows them
+void volk_cpu_fingerprint (char* buf, size_t len);
+// data cache sizes in bytes of L1, L2 and the last level, 0 where unknown
+void volk_cpu_cache_sizes (size_t* l1, size_t* l2, size_t* llc);
+// whether this build knows the denormal bits of the float control register
+int volk_cpu_can_flush_denormals (void);
+// set or clear those bits for the calling thread, returns their old state
+unsigned long long volk_cpu_flush_denormals (int enable);
+// put back a state returned by volk_cpu_flush_denormals
+void volk_cpu_restore_denormals (unsigned long long mode);
 
 __VOLK_DECL_END
 
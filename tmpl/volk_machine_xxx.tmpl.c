@@ -43,6 +43,10 @@ struct volk_machine volk_machine_${this_machine.name} = {
 <% make_impl_align_list = "{"+', '.join(['true' if i.is_aligned else 'false' for i in impls])+"}" %>    ${make_impl_align_list},
 ##//pointer to each implementation
 <% make_impl_fcn_list = "{"+', '.join(['%s_%s'%(kern.name, i.name) for i in impls])+"}" %>    ${make_impl_fcn_list},
+##//padded twin of each implementation
+    %if kern.has_padded:
+<% make_impl_padded_list = "{"+', '.join(['%s_%s'%(kern.name, i.name) if i else 'NULL' for i in kern.get_padded_impls(arch_names)])+"}" %>    ${make_impl_padded_list},
+    %endif
 ##//number of implementations listed here
 <% len_impls = len(impls) %>    ${len_impls},
     %endfor
@@ -28,6 +28,9 @@ struct volk_machine {
     const int ${kern.name}_impl_deps[${len_archs}];
     const bool ${kern.name}_impl_alignment[${len_archs}];
     const ${kern.pname} ${kern.name}_impls[${len_archs}];
+    %if kern.has_padded:
+    const ${kern.pname} ${kern.name}_impl_padded[${len_archs}]; //twin of each impl, or NULL
+    %endif
     const size_t ${kern.name}_n_impls;
     %endfor
 };